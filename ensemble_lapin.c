@@ -0,0 +1,1841 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Programme : ensemble_lapin.c                                          *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Simule un ensemble de répliques indépendantes de la population de     *
+ *      lapins et en donne des statistiques : moyenne, écart type, minimum    *
+ *      et maximum de la population de chaque année, nombre d'extinctions et  *
+ *      histogramme de la population finale.                                  *
+ *                                                                            *
+ *      Les répliques sont numérotées de 0 à nb_repliques - 1 et chacune a    *
+ *      son propre flux aléatoire, tiré de la graine et de son numéro (voir   *
+ *      SimulationCreerReplique). Elles sont réparties en rangs, à la façon   *
+ *      de MPI : le rang r simule une tranche contiguë de numéros avec        *
+ *      plusieurs threads, puis produit un agrégat partiel. Les agrégats ne   *
+ *      contiennent que des entiers exacts, leur fusion donne donc le même    *
+ *      résultat quel que soit le nombre de rangs, de threads ou l'ordre.     *
+ *                                                                            *
+ *      Il se compile comme suit (voir simu_fin.c et trajectoires.h pour les  *
+ *      bibliothèques) :                                                      *
+ *      gcc -Wall -O2 -fopenmp ensemble_lapin.c -L. -lsimu_traj -lsimu_lapin  *
+ *          -lm -o ensemble_lapin                                             *
+ *                                                                            *
+ *      Utilisation sur une seule machine, avec 4 processus reliés par des    *
+ *      tubes :                                                               *
+ *      ./ensemble_lapin -r 10000 -a 10 -p 4                                  *
+ *                                                                            *
+ *      Utilisation sur plusieurs machines : chaque rang écrit son agrégat    *
+ *      partiel dans un fichier, puis on les fusionne. Sans -k et -n, le      *
+ *      rang est lu dans les variables d'environnement des lanceurs MPI ou    *
+ *      Slurm (OMPI_COMM_WORLD_RANK, PMI_RANK, SLURM_PROCID, ...).            *
+ *      ./ensemble_lapin -r 100000000 -a 10 -k 3 -n 64 -o partiel_3.txt       *
+ *      ./ensemble_lapin -f partiel_*.txt                                     *
+ *      Chaque fichier partiel indique la tranche de blocs qu'il couvre : la  *
+ *      fusion est refusée si deux fichiers se chevauchent ou s'il en manque. *
+ *                                                                            *
+ *      Réduction de variance (-v) : les répliques sont groupées en blocs     *
+ *      consécutifs de même taille, simulés par le même rang, et la moyenne   *
+ *      de chaque bloc est un estimateur sans biais indépendant des autres    *
+ *      blocs. L'erreur type vient de la dispersion des blocs et la taille    *
+ *      d'échantillon effective (ESS) est le nombre de répliques              *
+ *      indépendantes qui donneraient la même erreur type. Les schémas        *
+ *      autres que mc utilisent les tirages agrégés de la bibliothèque, dont  *
+ *      le nombre de tirages par année est fixe :                             *
+ *        mc     Répliques indépendantes (blocs de 1)                         *
+ *        anti   Paires antithétiques : même flux, tirages u et 1 - u         *
+ *        strat  Hypercube latin sur les tirages des premières années (-d) :  *
+ *               chaque tirage est stratifié en -b strates dans le bloc       *
+ *        sobol  Points d'une suite de Sobol brouillée (Matoušek et décalage  *
+ *               digital) pour les tirages des premières années, un           *
+ *               brouillage indépendant par bloc de -b répliques              *
+ *      ./ensemble_lapin -r 4096 -a 10 -v sobol -b 64 -d 1                    *
+ *                                                                            *
+ *      Options :                                                             *
+ *      -r <n>   Nombre de répliques                                          *
+ *      -a <n>   Nombre d'années simulées (année 0 comprise, 10 par défaut)   *
+ *      -g <n>   Graine commune (5489 par défaut)                             *
+ *      -p <n>   Nombre de processus locaux (1 par défaut)                    *
+ *      -t <n>   Nombre de threads par processus                              *
+ *      -k <n>   Rang de ce processus                                         *
+ *      -n <n>   Nombre total de rangs                                        *
+ *      -o <f>   Écrit l'agrégat partiel dans ce fichier                      *
+ *      -f       Fusionne les fichiers partiels donnés en arguments           *
+ *      -v <s>   Schéma de réduction de variance : mc, anti, strat ou sobol   *
+ *      -b <n>   Taille des blocs de strat (16) et de sobol (64, puissance    *
+ *               de 2)                                                        *
+ *      -d <n>   Nombre d'années pilotées par strat et sobol (1, l'année des  *
+ *               fondateurs)                                                  *
+ *      -x       Tirages agrégés aussi pour mc                                *
+ *      -s <f>   Stocke les trajectoires de toutes les répliques dans ce      *
+ *               fichier (une tranche par rang avec -o, voir trajectoires.h), *
+ *               à relire avec lecteur_lapin                                  *
+ *      -z       Compresse le fichier de trajectoires (delta et varint)       *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <omp.h>
+
+#include "mt19937ar.h"
+#include "simu_lapin.h"
+#include "trajectoires.h"
+
+/* -------------------------------------------------------------------------- */
+/*                                Constantes                                  */
+/* -------------------------------------------------------------------------- */
+
+#define MAX_ANNEE 128
+#define NB_CLASSES_HISTO 65
+#define VERSION_PARTIEL 3
+#define BITS_SOBOL 32
+
+//  Code de retour quand une population ne tient plus sur 64 bits ou qu'une
+//  somme de l'agrégat ne tient plus sur 128 bits (-1 pour les autres échecs).
+#define ERREUR_DEPASSEMENT -2
+#define MESSAGE_DEPASSEMENT \
+    "Population trop grande pour être comptée exactement, réduire le nombre d'années\n"
+
+//  Schémas de réduction de variance.
+#define SCHEMA_MC 0
+#define SCHEMA_ANTITHETIQUE 1
+#define SCHEMA_STRATIFIE 2
+#define SCHEMA_SOBOL 3
+#define NB_SCHEMAS 4
+
+/* -------------------------------------------------------------------------- */
+/*                                  Types                                     */
+/* -------------------------------------------------------------------------- */
+
+//  Entier non signé sur 128 bits, pour que les sommes de carrés restent
+//  exactes même sur 10^8 répliques.
+typedef struct Entier128
+{
+    unsigned long long haut;
+    unsigned long long bas;
+} Entier128;
+
+/******************************************************************************
+ *                                                                            *
+ * Plan d'expérience de l'ensemble. La réplique r appartient au bloc          *
+ * r / taille_bloc. Avec strat et sobol, les dimension premiers tirages de    *
+ * chaque réplique (ceux des annees_plan premières années) viennent du plan   *
+ * de son bloc.                                                               *
+ *                                                                            *
+ ******************************************************************************/
+
+typedef struct Plan
+{
+    int schema;
+    int taille_bloc;
+    int annees_plan;
+    int dimension;
+    int agreges;
+} Plan;
+
+/******************************************************************************
+ *                                                                            *
+ * Agrégat d'un ensemble de répliques. Pour chaque année, on garde la somme   *
+ * et la somme des carrés de la population au début de l'année (femelles et   *
+ * mâles d'au moins un an), son minimum et son maximum. La classe i de        *
+ * l'histogramme compte les répliques dont la population finale s'écrit sur i *
+ * bits, la classe 0 correspond donc aux extinctions.                         *
+ *                                                                            *
+ * carres_blocs somme les carrés des sommes de chaque bloc, d'où l'on tire la *
+ * variance de l'estimateur de la moyenne quel que soit le schéma.            *
+ *                                                                            *
+ * Un agrégat partiel couvre les blocs debut à fin - 1 d'une expérience qui   *
+ * en compte blocs_total. La fusion vérifie que les tranches des rangs ne se  *
+ * chevauchent pas et couvrent exactement toute l'expérience.                 *
+ *                                                                            *
+ ******************************************************************************/
+
+typedef struct Agregat
+{
+    int nb_annee;
+    unsigned long graine;
+    Plan plan;
+    unsigned long long nb_repliques;
+    unsigned long long nb_blocs;
+    unsigned long long blocs_total;
+    unsigned long long debut;
+    unsigned long long fin;
+    Entier128 somme[MAX_ANNEE];
+    Entier128 carres[MAX_ANNEE];
+    Entier128 carres_blocs[MAX_ANNEE];
+    unsigned long long min[MAX_ANNEE];
+    unsigned long long max[MAX_ANNEE];
+    unsigned long long histogramme[NB_CLASSES_HISTO];
+} Agregat;
+
+//  Tranche de blocs couverte par un agrégat partiel, pour vérifier la fusion.
+typedef struct Tranche
+{
+    unsigned long long debut;
+    unsigned long long fin;
+} Tranche;
+
+//  Nombres de direction de la suite de Sobol, [Dimension][Bit].
+static unsigned long directions_sobol[SIMU_MAX_PREMIERS][BITS_SOBOL];
+
+static const char *noms_schemas[NB_SCHEMAS] = {"mc", "anti", "strat", "sobol"};
+
+//  Fichier de trajectoires de ce rang (-s), NULL s'il n'y en a pas. Les
+//  processus fils de LancerProcessus écrivent dans la projection héritée.
+static Trajectoires *stockage = NULL;
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+int SimulerTranche(Agregat *agregat, unsigned long long debut, unsigned long long fin);
+
+int SimulerBloc(Agregat *agregat, const ParametresSimu *params, unsigned long long bloc);
+
+int SimulerReplique(Agregat *agregat, const ParametresSimu *params, unsigned long long replique,
+                    const double *premiers, unsigned long long *population);
+
+void InitAgregat(Agregat *agregat, int nb_annee, unsigned long graine, const Plan *plan,
+                 unsigned long long blocs_total);
+
+int FusionnerAgregat(Agregat *total, const Agregat *partiel);
+
+int EcrireAgregat(FILE *fichier, const Agregat *agregat);
+
+int LireAgregat(FILE *fichier, Agregat *agregat);
+
+int VerifierTranches(Tranche *tranches, int nb_tranches, unsigned long long blocs_total,
+                     unsigned long long *bloc);
+
+int ComparerTranches(const void *a, const void *b);
+
+void AfficheAgregat(const Agregat *agregat);
+
+int LancerProcessus(Agregat *total, unsigned long long nb_blocs, int nb_processus);
+
+int RangEnvironnement(const char *noms[]);
+
+int CreerStockage(const char *chemin, int nb_annee, unsigned long long premiere_replique,
+                  unsigned long long nb_repliques, int compression);
+
+int LireSchema(const char *nom);
+
+int PreparerPlan(Plan *plan, int nb_annee);
+
+int GenererPlan(const Plan *plan, unsigned long graine, unsigned long long bloc, double *points);
+
+int PlanStratifie(mt_state *generateur, int taille_bloc, int dimension, double *points);
+
+void PlanSobol(mt_state *generateur, int taille_bloc, int dimension, double *points);
+
+void InitDirectionsSobol(int dimension);
+
+int PolynomePrimitif(unsigned long long polynome, int degre);
+
+unsigned long long PuissanceModulo(unsigned long long exposant, unsigned long long polynome, int degre);
+
+unsigned long long ProduitModulo(unsigned long long a, unsigned long long b, unsigned long long polynome, int degre);
+
+int Parite(unsigned long x);
+
+double UniformeOuverte(mt_state *generateur);
+
+int Ajouter128(Entier128 *a, Entier128 b);
+
+Entier128 Produit64(unsigned long long x, unsigned long long y);
+
+long double VersFlottant(Entier128 a);
+
+/* -------------------------------------------------------------------------- */
+/*                         Fonction 'main' principale                         */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[])
+{
+
+    int i, option, fusion = 0, nb_processus = 1, rang = -1, nb_rangs = -1, compression = TRAJ_BRUT, erreur;
+    int nb_annee = 10;
+    unsigned long graine = 5489UL;
+    unsigned long long nb_repliques = 0, nb_blocs, debut, fin, bloc;
+    Plan plan = {SCHEMA_MC, 0, 1, 0, 0};
+    const char *sortie = NULL, *chemin_trajectoires = NULL;
+    const char *noms_rang[] = {"OMPI_COMM_WORLD_RANK", "PMI_RANK", "SLURM_PROCID", NULL};
+    const char *noms_taille[] = {"OMPI_COMM_WORLD_SIZE", "PMI_SIZE", "SLURM_NTASKS", NULL};
+    static Agregat total, partiel;
+    Tranche *tranches;
+    FILE *fichier;
+
+    while ((option = getopt(argc, argv, "r:a:g:p:t:k:n:o:fv:b:d:xs:z")) != -1)
+    {
+        switch (option)
+        {
+        case 'r':
+            nb_repliques = strtoull(optarg, NULL, 10);
+            break;
+        case 'a':
+            nb_annee = atoi(optarg);
+            break;
+        case 'g':
+            graine = strtoul(optarg, NULL, 10);
+            break;
+        case 'p':
+            nb_processus = atoi(optarg);
+            break;
+        case 't':
+            omp_set_num_threads(atoi(optarg));
+            break;
+        case 'k':
+            rang = atoi(optarg);
+            break;
+        case 'n':
+            nb_rangs = atoi(optarg);
+            break;
+        case 'o':
+            sortie = optarg;
+            break;
+        case 'f':
+            fusion = 1;
+            break;
+        case 'v':
+            plan.schema = LireSchema(optarg);
+            break;
+        case 'b':
+            plan.taille_bloc = atoi(optarg);
+            break;
+        case 'd':
+            plan.annees_plan = atoi(optarg);
+            break;
+        case 'x':
+            plan.agreges = 1;
+            break;
+        case 's':
+            chemin_trajectoires = optarg;
+            break;
+        case 'z':
+            compression = TRAJ_DELTA;
+            break;
+        default:
+            fprintf(stderr, "Usage : %s -r <répliques> [-a années] [-g graine] [-p processus] [-t threads]\n"
+                            "        [-v mc|anti|strat|sobol] [-b bloc] [-d années pilotées] [-x] [-s trajectoires [-z]]\n"
+                            "        %s -r <répliques> -o <fichier> [-k rang -n rangs] ...\n"
+                            "        %s -f <fichiers partiels...>\n",
+                    argv[0], argv[0], argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    //  Mode fusion : on additionne les agrégats partiels des différents rangs.
+    if (fusion)
+    {
+        if (optind == argc)
+        {
+            fprintf(stderr, "Aucun fichier partiel à fusionner\n");
+            return EXIT_FAILURE;
+        }
+
+        tranches = (Tranche *)malloc((argc - optind) * sizeof(Tranche));
+        if (tranches == NULL)
+        {
+            fprintf(stderr, "Mémoire insuffisante\n");
+            return EXIT_FAILURE;
+        }
+
+        //  Le premier fichier donne l'expérience, les suivants doivent porter
+        //  sur la même.
+        for (i = optind; i < argc; i++)
+        {
+            fichier = fopen(argv[i], "r");
+            erreur = fichier == NULL || LireAgregat(fichier, i == optind ? &total : &partiel) != 0 ? -1 : 0;
+            if (erreur == 0 && i > optind)
+            {
+                erreur = FusionnerAgregat(&total, &partiel);
+            }
+            if (erreur != 0)
+            {
+                if (erreur == ERREUR_DEPASSEMENT)
+                {
+                    fprintf(stderr, MESSAGE_DEPASSEMENT);
+                }
+                else
+                {
+                    fprintf(stderr, "Fichier partiel invalide ou incompatible : %s\n", argv[i]);
+                }
+                free(tranches);
+                return EXIT_FAILURE;
+            }
+            fclose(fichier);
+
+            tranches[i - optind].debut = i == optind ? total.debut : partiel.debut;
+            tranches[i - optind].fin = i == optind ? total.fin : partiel.fin;
+        }
+
+        //  Un fichier donné deux fois ou un rang oublié donnerait des
+        //  statistiques fausses sans que rien ne le montre.
+        erreur = VerifierTranches(tranches, argc - optind, total.blocs_total, &bloc);
+        free(tranches);
+        if (erreur != 0)
+        {
+            fprintf(stderr, erreur == -1 ? "Le bloc %llu est couvert par plusieurs fichiers partiels\n"
+                                         : "Le bloc %llu n'est couvert par aucun fichier partiel\n",
+                    bloc);
+            return EXIT_FAILURE;
+        }
+
+        AfficheAgregat(&total);
+        return EXIT_SUCCESS;
+    }
+
+    if (nb_repliques == 0 || nb_annee < 1 || nb_annee > MAX_ANNEE || nb_processus < 1)
+    {
+        fprintf(stderr, "Il faut au moins une réplique, entre 1 et %d années et un processus\n", MAX_ANNEE);
+        return EXIT_FAILURE;
+    }
+
+    if (PreparerPlan(&plan, nb_annee) != 0)
+    {
+        fprintf(stderr, "Schéma de réduction de variance invalide (voir l'en-tête du programme)\n");
+        return EXIT_FAILURE;
+    }
+
+    //  On simule des blocs entiers : le nombre de répliques est arrondi au
+    //  multiple supérieur de la taille des blocs.
+    nb_blocs = (nb_repliques + plan.taille_bloc - 1) / plan.taille_bloc;
+
+    InitAgregat(&total, nb_annee, graine, &plan, nb_blocs);
+
+    //  Mode rang : ce processus ne simule que sa tranche et écrit son agrégat
+    //  partiel, qui sera fusionné plus tard avec -f.
+    if (sortie != NULL)
+    {
+        if (rang < 0)
+        {
+            rang = RangEnvironnement(noms_rang);
+        }
+        if (nb_rangs < 0)
+        {
+            nb_rangs = RangEnvironnement(noms_taille);
+        }
+        if (rang < 0 || nb_rangs < 1 || rang >= nb_rangs)
+        {
+            rang = 0;
+            nb_rangs = 1;
+        }
+
+        debut = nb_blocs * rang / nb_rangs;
+        fin = nb_blocs * (rang + 1) / nb_rangs;
+
+        if (chemin_trajectoires != NULL && fin > debut &&
+            CreerStockage(chemin_trajectoires, nb_annee, debut * plan.taille_bloc,
+                          (fin - debut) * plan.taille_bloc, compression) != 0)
+        {
+            fprintf(stderr, "Impossible de créer %s\n", chemin_trajectoires);
+            return EXIT_FAILURE;
+        }
+
+        erreur = SimulerTranche(&total, debut, fin);
+        if (erreur != 0 || TrajectoiresFermer(stockage) != SIMU_OK)
+        {
+            fprintf(stderr, erreur == ERREUR_DEPASSEMENT ? MESSAGE_DEPASSEMENT
+                                                         : "Mémoire insuffisante ou fichier de trajectoires inutilisable\n");
+            return EXIT_FAILURE;
+        }
+
+        fichier = fopen(sortie, "w");
+        if (fichier == NULL || EcrireAgregat(fichier, &total) != 0 || fclose(fichier) != 0)
+        {
+            fprintf(stderr, "Impossible d'écrire %s\n", sortie);
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    //  Mode local : on lance nb_processus rangs sur cette machine, qui
+    //  écrivent tous dans le même fichier de trajectoires.
+    if (chemin_trajectoires != NULL &&
+        CreerStockage(chemin_trajectoires, nb_annee, 0, nb_blocs * plan.taille_bloc, compression) != 0)
+    {
+        fprintf(stderr, "Impossible de créer %s\n", chemin_trajectoires);
+        return EXIT_FAILURE;
+    }
+
+    erreur = LancerProcessus(&total, nb_blocs, nb_processus);
+    if (erreur != 0 || TrajectoiresFermer(stockage) != SIMU_OK)
+    {
+        fprintf(stderr, erreur == ERREUR_DEPASSEMENT ? MESSAGE_DEPASSEMENT : "Échec d'un des processus de l'ensemble\n");
+        return EXIT_FAILURE;
+    }
+
+    AfficheAgregat(&total);
+
+    return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                       Fonctions servant au programme                       */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int LancerProcessus(Agregat *total,                             *
+ *                      unsigned long long nb_blocs, int nb_processus)        *
+ *                                                                            *
+ * Crée un processus par rang. Chacun simule sa tranche de blocs et           *
+ * renvoie son agrégat partiel par un tube, au même format que les fichiers   *
+ * partiels. Les agrégats sont lus et fusionnés dans l'ordre des rangs, après *
+ * avoir vérifié que chacun couvre bien la tranche de son rang.               *
+ *                                                                            *
+ * En entrée : L'agrégat total, déjà initialisé                               *
+ *             Le nombre total de blocs                                       *
+ *             Le nombre de processus                                         *
+ *                                                                            *
+ * En sortie : 0 si tous les processus ont réussi                             *
+ *             ERREUR_DEPASSEMENT si une population ou une somme a dépassé    *
+ *             -1 sinon.                                                      *
+ *                                                                            *
+ ******************************************************************************/
+
+int LancerProcessus(Agregat *total, unsigned long long nb_blocs, int nb_processus)
+{
+
+    int rang, nb_lances, statut, code, erreur = 0;
+    int *tubes = (int *)malloc(nb_processus * sizeof(int));
+    pid_t *pids = (pid_t *)malloc(nb_processus * sizeof(pid_t));
+    int tube[2];
+    static Agregat partiel;
+    FILE *flux;
+
+    if (tubes == NULL || pids == NULL)
+    {
+        free(tubes);
+        free(pids);
+        return -1;
+    }
+
+    for (rang = 0; rang < nb_processus; rang++)
+    {
+        if (pipe(tube) != 0)
+        {
+            erreur = -1;
+            break;
+        }
+
+        fflush(stdout);
+        pids[rang] = fork();
+
+        if (pids[rang] < 0)
+        {
+            close(tube[0]);
+            close(tube[1]);
+            erreur = -1;
+            break;
+        }
+
+        if (pids[rang] == 0)
+        {
+            //  Processus fils : il n'a besoin que de l'écriture de son tube.
+            close(tube[0]);
+            InitAgregat(&partiel, total->nb_annee, total->graine, &total->plan, nb_blocs);
+
+            //  Le statut 2 signale un dépassement au processus père.
+            flux = fdopen(tube[1], "w");
+            code = flux == NULL ? -1
+                                : SimulerTranche(&partiel, nb_blocs * rang / nb_processus,
+                                                 nb_blocs * (rang + 1) / nb_processus);
+            if (code != 0 || EcrireAgregat(flux, &partiel) != 0 || fclose(flux) != 0)
+            {
+                _exit(code == ERREUR_DEPASSEMENT ? 2 : EXIT_FAILURE);
+            }
+            _exit(EXIT_SUCCESS);
+        }
+
+        close(tube[1]);
+        tubes[rang] = tube[0];
+    }
+
+    nb_lances = rang;
+
+    for (rang = 0; rang < nb_lances; rang++)
+    {
+        flux = fdopen(tubes[rang], "r");
+
+        if (flux == NULL || LireAgregat(flux, &partiel) != 0 ||
+            partiel.debut != nb_blocs * rang / nb_processus || partiel.fin != nb_blocs * (rang + 1) / nb_processus)
+        {
+            erreur = erreur != 0 ? erreur : -1;
+        }
+        else if ((code = FusionnerAgregat(total, &partiel)) != 0)
+        {
+            erreur = code;
+        }
+
+        if (flux != NULL)
+        {
+            fclose(flux);
+        }
+        else
+        {
+            close(tubes[rang]);
+        }
+
+        if (waitpid(pids[rang], &statut, 0) < 0 || !WIFEXITED(statut))
+        {
+            erreur = -1;
+        }
+        else if (WEXITSTATUS(statut) != EXIT_SUCCESS)
+        {
+            erreur = WEXITSTATUS(statut) == 2 ? ERREUR_DEPASSEMENT : -1;
+        }
+    }
+
+    free(tubes);
+    free(pids);
+
+    return erreur;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulerTranche(Agregat *agregat, unsigned long long debut,  *
+ *                               unsigned long long fin)                      *
+ *                                                                            *
+ * Simule les blocs debut à fin - 1 avec tous les threads disponibles.        *
+ * Chaque thread remplit son propre agrégat, fusionné à la fin dans agregat.  *
+ *                                                                            *
+ * En entrée : L'agrégat à compléter, déjà initialisé                         *
+ *             Le premier numéro de bloc et le numéro qui suit le dernier     *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             ERREUR_DEPASSEMENT si une population ou une somme a dépassé    *
+ *             -1 si la mémoire a manqué.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulerTranche(Agregat *agregat, unsigned long long debut, unsigned long long fin)
+{
+
+    int erreur = 0;
+    ParametresSimu params;
+
+    ParametresSimuDefaut(&params);
+    params.graine = agregat->graine;
+    params.tirages_agreges = agregat->plan.agreges;
+
+    agregat->debut = debut;
+    agregat->fin = fin;
+
+#pragma omp parallel
+    {
+        long long i;
+        Agregat *local = (Agregat *)malloc(sizeof(Agregat));
+
+        if (local == NULL)
+        {
+#pragma omp atomic write
+            erreur = -1;
+        }
+        else
+        {
+            InitAgregat(local, agregat->nb_annee, agregat->graine, &agregat->plan, agregat->blocs_total);
+        }
+
+#pragma omp for schedule(dynamic, 1)
+        for (i = (long long)debut; i < (long long)fin; i++)
+        {
+            int code = local != NULL ? SimulerBloc(local, &params, (unsigned long long)i) : 0;
+
+            if (code != 0)
+            {
+#pragma omp atomic write
+                erreur = code;
+            }
+        }
+
+        if (local != NULL)
+        {
+#pragma omp critical
+            {
+                if (FusionnerAgregat(agregat, local) != 0)
+                {
+#pragma omp atomic write
+                    erreur = ERREUR_DEPASSEMENT;
+                }
+            }
+
+            free(local);
+        }
+    }
+
+    return erreur;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulerBloc(Agregat *agregat,                               *
+ *                            const ParametresSimu *params,                   *
+ *                            unsigned long long bloc)                        *
+ *                                                                            *
+ * Simule les répliques d'un bloc avec le plan d'expérience de l'agrégat,     *
+ * les ajoute à l'agrégat puis y ajoute le carré de la somme du bloc.         *
+ *                                                                            *
+ * En entrée : L'agrégat à compléter                                          *
+ *             Les paramètres du modèle                                       *
+ *             Le numéro du bloc                                              *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             ERREUR_DEPASSEMENT si une population ou une somme a dépassé    *
+ *             -1 si la mémoire a manqué.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulerBloc(Agregat *agregat, const ParametresSimu *params, unsigned long long bloc)
+{
+
+    int m, annee, erreur = 0;
+    const Plan *plan = &agregat->plan;
+    unsigned long long population[MAX_ANNEE], somme[MAX_ANNEE] = {0};
+    double *points = NULL;
+
+    if (plan->dimension > 0)
+    {
+        points = (double *)malloc((size_t)plan->taille_bloc * plan->dimension * sizeof(double));
+        if (points == NULL || GenererPlan(plan, agregat->graine, bloc, points) != 0)
+        {
+            free(points);
+            return -1;
+        }
+    }
+
+    for (m = 0; m < plan->taille_bloc && erreur == 0; m++)
+    {
+        erreur = SimulerReplique(agregat, params, bloc * plan->taille_bloc + m,
+                                 points != NULL ? points + (size_t)m * plan->dimension : NULL, population);
+
+        for (annee = 0; annee < agregat->nb_annee && erreur == 0; annee++)
+        {
+            if (population[annee] > ~0ULL - somme[annee])
+            {
+                erreur = ERREUR_DEPASSEMENT;
+            }
+            somme[annee] += population[annee];
+        }
+    }
+
+    if (erreur == 0)
+    {
+        for (annee = 0; annee < agregat->nb_annee; annee++)
+        {
+            if (Ajouter128(&agregat->carres_blocs[annee], Produit64(somme[annee], somme[annee])) != 0)
+            {
+                erreur = ERREUR_DEPASSEMENT;
+            }
+        }
+        agregat->nb_blocs++;
+    }
+
+    free(points);
+
+    return erreur;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulerReplique(Agregat *agregat,                           *
+ *                    const ParametresSimu *params,                           *
+ *                    unsigned long long replique, const double *premiers,    *
+ *                    unsigned long long *population)                         *
+ *                                                                            *
+ * Simule une réplique avec les conditions initiales de simu_fin.c (10        *
+ * femelles et 10 mâles de 10 ans), l'ajoute à l'agrégat et, avec -s, écrit   *
+ * sa trajectoire dans le fichier de trajectoires.                            *
+ *                                                                            *
+ * En entrée : L'agrégat à compléter                                          *
+ *             Les paramètres du modèle                                       *
+ *             Le numéro de la réplique                                       *
+ *             Les tirages imposés par le plan (NULL s'il n'y en a pas)       *
+ *             Le tableau à remplir avec la population de chaque année        *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             ERREUR_DEPASSEMENT si la population ne tient plus sur 64 bits  *
+ *             ou si une somme de l'agrégat dépasse 128 bits                  *
+ *             -1 si la mémoire a manqué ou si l'écriture a échoué.           *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulerReplique(Agregat *agregat, const ParametresSimu *params, unsigned long long replique,
+                    const double *premiers, unsigned long long *population)
+{
+
+    int annee, age, classe = 0, code;
+    int antithetique = agregat->plan.schema == SCHEMA_ANTITHETIQUE;
+    const unsigned long long *femelles, *males;
+    Simulation *sim;
+
+    //  Les deux répliques d'une paire antithétique partagent le flux de leur
+    //  bloc, la seconde prend les tirages opposés.
+    sim = SimulationCreerReplique(params, antithetique ? replique / 2 : replique);
+    if (sim == NULL)
+    {
+        return -1;
+    }
+
+    SimulationFixerTirages(sim, antithetique && replique % 2 == 1, premiers,
+                           premiers != NULL ? agregat->plan.dimension : 0);
+    SimulationPeupler(sim, SIMU_FEMELLES, 10, 10);
+    SimulationPeupler(sim, SIMU_MALES, 10, 10);
+
+    //  Une population trop grande arrête l'ensemble : ses statistiques
+    //  seraient fausses.
+    code = SimulationAvancer(sim, agregat->nb_annee - 1);
+    if (code != SIMU_OK ||
+        (stockage != NULL && TrajectoiresEcrire(stockage, replique, SimulationDonnees(sim)) != SIMU_OK))
+    {
+        SimulationDetruire(sim);
+        return code == SIMU_ERREUR_DEPASSEMENT ? ERREUR_DEPASSEMENT : -1;
+    }
+
+    for (annee = 0; annee < agregat->nb_annee; annee++)
+    {
+        femelles = SimulationCohorte(sim, annee, SIMU_FEMELLES);
+        males = SimulationCohorte(sim, annee, SIMU_MALES);
+        population[annee] = 0;
+
+        //  Les naissances de la dernière année ne sont pas calculées, on compte
+        //  donc les lapins présents au début de chaque année (âge 1 et plus).
+        for (age = 1; age < SimulationAgeMax(sim); age++)
+        {
+            population[annee] += femelles[age] + males[age];
+        }
+
+        if (Ajouter128(&agregat->somme[annee], Produit64(population[annee], 1)) != 0 ||
+            Ajouter128(&agregat->carres[annee], Produit64(population[annee], population[annee])) != 0)
+        {
+            SimulationDetruire(sim);
+            return ERREUR_DEPASSEMENT;
+        }
+
+        if (population[annee] < agregat->min[annee])
+        {
+            agregat->min[annee] = population[annee];
+        }
+        if (population[annee] > agregat->max[annee])
+        {
+            agregat->max[annee] = population[annee];
+        }
+    }
+
+    //  La classe de l'histogramme est le nombre de bits de la population finale.
+    while (population[agregat->nb_annee - 1] >> classe != 0)
+    {
+        classe++;
+    }
+    agregat->histogramme[classe]++;
+    agregat->nb_repliques++;
+
+    SimulationDetruire(sim);
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void InitAgregat(Agregat *agregat, int nb_annee,                *
+ *                  unsigned long graine, const Plan *plan,                   *
+ *                  unsigned long long blocs_total)                           *
+ *                                                                            *
+ * Prépare un agrégat vide, qui ne couvre encore aucun bloc.                  *
+ *                                                                            *
+ * En entrée : L'agrégat                                                      *
+ *             Le nombre d'années simulées                                    *
+ *             La graine commune de l'ensemble                                *
+ *             Le plan d'expérience, déjà préparé                             *
+ *             Le nombre de blocs de toute l'expérience                       *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void InitAgregat(Agregat *agregat, int nb_annee, unsigned long graine, const Plan *plan,
+                 unsigned long long blocs_total)
+{
+
+    int i;
+
+    memset(agregat, 0, sizeof(Agregat));
+    agregat->nb_annee = nb_annee;
+    agregat->graine = graine;
+    agregat->plan = *plan;
+    agregat->blocs_total = blocs_total;
+
+    for (i = 0; i < MAX_ANNEE; i++)
+    {
+        agregat->min[i] = ~0ULL;
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int FusionnerAgregat(Agregat *total, const Agregat *partiel)    *
+ *                                                                            *
+ * Ajoute un agrégat partiel à un total. Toutes les opérations sont des       *
+ * additions, minimums et maximums d'entiers : le résultat ne dépend pas de   *
+ * l'ordre des fusions. Les tranches ne sont pas fusionnées, c'est            *
+ * VerifierTranches qui contrôle qu'elles couvrent l'expérience.              *
+ *                                                                            *
+ * En entrée : L'agrégat total                                                *
+ *             L'agrégat partiel                                              *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             -1 si les deux agrégats ne portent pas sur la même expérience  *
+ *             ERREUR_DEPASSEMENT si une somme dépasse 128 bits.              *
+ *                                                                            *
+ ******************************************************************************/
+
+int FusionnerAgregat(Agregat *total, const Agregat *partiel)
+{
+
+    int i;
+
+    if (total->nb_annee != partiel->nb_annee || total->graine != partiel->graine ||
+        total->blocs_total != partiel->blocs_total || memcmp(&total->plan, &partiel->plan, sizeof(Plan)) != 0)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < total->nb_annee; i++)
+    {
+        if (Ajouter128(&total->somme[i], partiel->somme[i]) != 0 ||
+            Ajouter128(&total->carres[i], partiel->carres[i]) != 0 ||
+            Ajouter128(&total->carres_blocs[i], partiel->carres_blocs[i]) != 0)
+        {
+            return ERREUR_DEPASSEMENT;
+        }
+
+        if (partiel->min[i] < total->min[i])
+        {
+            total->min[i] = partiel->min[i];
+        }
+        if (partiel->max[i] > total->max[i])
+        {
+            total->max[i] = partiel->max[i];
+        }
+    }
+
+    for (i = 0; i < NB_CLASSES_HISTO; i++)
+    {
+        total->histogramme[i] += partiel->histogramme[i];
+    }
+
+    total->nb_repliques += partiel->nb_repliques;
+    total->nb_blocs += partiel->nb_blocs;
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int EcrireAgregat(FILE *fichier, const Agregat *agregat)        *
+ *                                                                            *
+ * Écrit un agrégat partiel sous forme de texte, sans perte : toutes les      *
+ * valeurs sont des entiers. La tranche de blocs couverte et le nombre de     *
+ * blocs de l'expérience sont écrits avec le plan.                            *
+ *                                                                            *
+ * En entrée : Le fichier (ou le tube) ouvert en écriture                     *
+ *             L'agrégat                                                      *
+ *                                                                            *
+ * En sortie : 0 si l'écriture a réussi                                       *
+ *             -1 sinon.                                                      *
+ *                                                                            *
+ ******************************************************************************/
+
+int EcrireAgregat(FILE *fichier, const Agregat *agregat)
+{
+
+    int i;
+
+    fprintf(fichier, "partiel %d\n", VERSION_PARTIEL);
+    fprintf(fichier, "annees %d graine %lu repliques %llu\n",
+            agregat->nb_annee, agregat->graine, agregat->nb_repliques);
+    fprintf(fichier, "plan %d %d %d %d %d blocs %llu\n",
+            agregat->plan.schema, agregat->plan.taille_bloc, agregat->plan.annees_plan,
+            agregat->plan.dimension, agregat->plan.agreges, agregat->nb_blocs);
+    fprintf(fichier, "tranche %llu %llu sur %llu\n", agregat->debut, agregat->fin, agregat->blocs_total);
+
+    for (i = 0; i < agregat->nb_annee; i++)
+    {
+        fprintf(fichier, "%llu %llu %llu %llu %llu %llu %llu %llu\n",
+                agregat->somme[i].haut, agregat->somme[i].bas,
+                agregat->carres[i].haut, agregat->carres[i].bas,
+                agregat->carres_blocs[i].haut, agregat->carres_blocs[i].bas,
+                agregat->min[i], agregat->max[i]);
+    }
+
+    for (i = 0; i < NB_CLASSES_HISTO; i++)
+    {
+        fprintf(fichier, "%llu\n", agregat->histogramme[i]);
+    }
+
+    return ferror(fichier) ? -1 : 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int LireAgregat(FILE *fichier, Agregat *agregat)                *
+ *                                                                            *
+ * Relit un agrégat écrit par EcrireAgregat.                                  *
+ *                                                                            *
+ * En entrée : Le fichier (ou le tube) ouvert en lecture                      *
+ *             L'agrégat à remplir                                            *
+ *                                                                            *
+ * En sortie : 0 si la lecture a réussi                                       *
+ *             -1 si le contenu est invalide.                                 *
+ *                                                                            *
+ ******************************************************************************/
+
+int LireAgregat(FILE *fichier, Agregat *agregat)
+{
+
+    int i, version, nb_annee;
+    unsigned long graine;
+    unsigned long long nb_repliques, nb_blocs, debut, fin, blocs_total;
+    Plan plan;
+
+    if (fscanf(fichier, "partiel %d annees %d graine %lu repliques %llu", &version, &nb_annee, &graine,
+               &nb_repliques) != 4 ||
+        version != VERSION_PARTIEL || nb_annee < 1 || nb_annee > MAX_ANNEE)
+    {
+        return -1;
+    }
+
+    if (fscanf(fichier, " plan %d %d %d %d %d blocs %llu", &plan.schema, &plan.taille_bloc,
+               &plan.annees_plan, &plan.dimension, &plan.agreges, &nb_blocs) != 6 ||
+        plan.schema < 0 || plan.schema >= NB_SCHEMAS || plan.taille_bloc < 1)
+    {
+        return -1;
+    }
+
+    //  Le nombre de blocs doit correspondre à la tranche annoncée.
+    if (fscanf(fichier, " tranche %llu %llu sur %llu", &debut, &fin, &blocs_total) != 3 ||
+        debut > fin || fin > blocs_total || nb_blocs != fin - debut)
+    {
+        return -1;
+    }
+
+    InitAgregat(agregat, nb_annee, graine, &plan, blocs_total);
+    agregat->nb_repliques = nb_repliques;
+    agregat->nb_blocs = nb_blocs;
+    agregat->debut = debut;
+    agregat->fin = fin;
+
+    for (i = 0; i < nb_annee; i++)
+    {
+        if (fscanf(fichier, "%llu %llu %llu %llu %llu %llu %llu %llu",
+                   &agregat->somme[i].haut, &agregat->somme[i].bas,
+                   &agregat->carres[i].haut, &agregat->carres[i].bas,
+                   &agregat->carres_blocs[i].haut, &agregat->carres_blocs[i].bas,
+                   &agregat->min[i], &agregat->max[i]) != 8)
+        {
+            return -1;
+        }
+    }
+
+    for (i = 0; i < NB_CLASSES_HISTO; i++)
+    {
+        if (fscanf(fichier, "%llu", &agregat->histogramme[i]) != 1)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int VerifierTranches(Tranche *tranches, int nb_tranches,        *
+ *                  unsigned long long blocs_total, unsigned long long *bloc) *
+ *                                                                            *
+ * Vérifie que les tranches des agrégats partiels fusionnés couvrent chaque   *
+ * bloc de l'expérience exactement une fois. Les tranches sont triées par     *
+ * leur début, les tranches vides (rangs sans bloc) sont ignorées.            *
+ *                                                                            *
+ * En entrée : Les tranches, dans n'importe quel ordre                        *
+ *             Le nombre de tranches                                          *
+ *             Le nombre de blocs de l'expérience                             *
+ *             Où ranger le premier bloc en défaut                            *
+ *                                                                            *
+ * En sortie : 0 si la couverture est exacte                                  *
+ *             -1 si un bloc est couvert plusieurs fois                       *
+ *             -2 si un bloc n'est pas couvert.                               *
+ *                                                                            *
+ ******************************************************************************/
+
+int VerifierTranches(Tranche *tranches, int nb_tranches, unsigned long long blocs_total,
+                     unsigned long long *bloc)
+{
+
+    int i;
+    unsigned long long couverts = 0;
+
+    qsort(tranches, nb_tranches, sizeof(Tranche), ComparerTranches);
+
+    //  couverts est le début de la partie de l'expérience qui reste à couvrir.
+    for (i = 0; i < nb_tranches; i++)
+    {
+        if (tranches[i].debut == tranches[i].fin)
+        {
+            continue;
+        }
+        if (tranches[i].debut < couverts)
+        {
+            *bloc = tranches[i].debut;
+            return -1;
+        }
+        if (tranches[i].debut > couverts)
+        {
+            *bloc = couverts;
+            return -2;
+        }
+        couverts = tranches[i].fin;
+    }
+
+    if (couverts != blocs_total)
+    {
+        *bloc = couverts;
+        return -2;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int ComparerTranches(const void *a, const void *b)              *
+ *                                                                            *
+ * Ordre de qsort sur les tranches : par début croissant.                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int ComparerTranches(const void *a, const void *b)
+{
+
+    const Tranche *x = (const Tranche *)a, *y = (const Tranche *)b;
+
+    return (x->debut > y->debut) - (x->debut < y->debut);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void AfficheAgregat(const Agregat *agregat)                     *
+ *                                                                            *
+ * Affiche les statistiques de l'ensemble : pour chaque année la moyenne,     *
+ * l'écart type, l'erreur type de la moyenne (tirée de la dispersion des      *
+ * blocs), la taille d'échantillon effective, le minimum et le maximum de la  *
+ * population, puis l'histogramme de la population finale par puissances de   *
+ * 2. L'ESS vaut écart type² / erreur type² : c'est le nombre de répliques    *
+ * indépendantes qui donneraient la même précision, égal au nombre de         *
+ * répliques pour mc.                                                         *
+ *                                                                            *
+ * En entrée : L'agrégat                                                      *
+ *                                                                            *
+ * En sortie : Rien, cette fonction ne fait que de l'affichage.               *
+ *                                                                            *
+ ******************************************************************************/
+
+void AfficheAgregat(const Agregat *agregat)
+{
+
+    int i;
+    long double n = agregat->nb_repliques, b = agregat->nb_blocs, moyenne, variance;
+    long double somme_bloc, variance_blocs, variance_moyenne;
+    const Plan *plan = &agregat->plan;
+
+    printf("Répliques : %llu    Graine : %lu\n", agregat->nb_repliques, agregat->graine);
+    printf("Schéma : %s    Blocs : %llu de %d répliques", noms_schemas[plan->schema], agregat->nb_blocs,
+           plan->taille_bloc);
+    if (plan->dimension > 0)
+    {
+        printf("    Tirages pilotés : %d", plan->dimension);
+    }
+    printf("%s\n\n", plan->agreges ? "    Tirages agrégés" : "");
+    printf("%6s %16s %16s %14s %14s %12s %12s\n", "Année", "Moyenne", "Écart type", "Erreur type", "ESS",
+           "Minimum", "Maximum");
+
+    for (i = 0; i < agregat->nb_annee && agregat->nb_repliques > 0; i++)
+    {
+        moyenne = VersFlottant(agregat->somme[i]) / n;
+        variance = 0;
+        if (agregat->nb_repliques > 1)
+        {
+            variance = (VersFlottant(agregat->carres[i]) - n * moyenne * moyenne) / (n - 1);
+        }
+        if (variance < 0)
+        {
+            variance = 0;
+        }
+
+        //  Variance des sommes de blocs, puis de la moyenne générale.
+        somme_bloc = VersFlottant(agregat->somme[i]) / b;
+        variance_blocs = 0;
+        if (agregat->nb_blocs > 1)
+        {
+            variance_blocs = (VersFlottant(agregat->carres_blocs[i]) - b * somme_bloc * somme_bloc) / (b - 1);
+        }
+        if (variance_blocs < 0)
+        {
+            variance_blocs = 0;
+        }
+        variance_moyenne = variance_blocs / (b * plan->taille_bloc * plan->taille_bloc);
+
+        printf("%6d %16.3Lf %16.3Lf %14.4Lf ", i, moyenne, sqrtl(variance), sqrtl(variance_moyenne));
+        if (variance_moyenne > 0)
+        {
+            printf("%14.0Lf", variance / variance_moyenne);
+        }
+        else
+        {
+            printf("%14s", "-");
+        }
+        printf(" %12llu %12llu\n", agregat->min[i], agregat->max[i]);
+    }
+
+    printf("\nPopulation finale (extinctions : %llu)\n", agregat->histogramme[0]);
+    for (i = 1; i < NB_CLASSES_HISTO; i++)
+    {
+        if (agregat->histogramme[i] > 0)
+        {
+            printf("  [%llu, %llu] : %llu\n", 1ULL << (i - 1), i == 64 ? ~0ULL : (1ULL << i) - 1,
+                   agregat->histogramme[i]);
+        }
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int RangEnvironnement(const char *noms[])                       *
+ *                                                                            *
+ * Cherche un entier dans la première variable d'environnement définie parmi  *
+ * noms, pour retrouver le rang fixé par un lanceur (mpirun, srun, ...).      *
+ *                                                                            *
+ * En entrée : La liste des noms, terminée par NULL.                          *
+ *                                                                            *
+ * En sortie : La valeur trouvée, -1 si aucune variable n'est définie.        *
+ *                                                                            *
+ ******************************************************************************/
+
+int RangEnvironnement(const char *noms[])
+{
+
+    int i;
+    const char *valeur;
+
+    for (i = 0; noms[i] != NULL; i++)
+    {
+        valeur = getenv(noms[i]);
+        if (valeur != NULL)
+        {
+            return atoi(valeur);
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int CreerStockage(const char *chemin, int nb_annee,             *
+ *                  unsigned long long premiere_replique,                     *
+ *                  unsigned long long nb_repliques, int compression)         *
+ *                                                                            *
+ * Crée le fichier de trajectoires de ce rang, pour le nombre de classes      *
+ * d'âge du modèle par défaut.                                                *
+ *                                                                            *
+ * En entrée : Le chemin du fichier                                           *
+ *             Le nombre d'années simulées                                    *
+ *             La première réplique et le nombre de répliques de ce rang      *
+ *             TRAJ_BRUT ou TRAJ_DELTA                                        *
+ *                                                                            *
+ * En sortie : 0 si le fichier est créé                                       *
+ *             -1 sinon.                                                      *
+ *                                                                            *
+ ******************************************************************************/
+
+int CreerStockage(const char *chemin, int nb_annee, unsigned long long premiere_replique,
+                  unsigned long long nb_repliques, int compression)
+{
+
+    ParametresSimu params;
+
+    ParametresSimuDefaut(&params);
+    stockage = TrajectoiresCreer(chemin, params.age_max, nb_annee, premiere_replique, nb_repliques,
+                                 compression);
+
+    return stockage != NULL ? 0 : -1;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                           Plans d'expérience                               */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int LireSchema(const char *nom)                                 *
+ *                                                                            *
+ * En sortie : Le numéro du schéma de réduction de variance nommé nom         *
+ *             -1 s'il n'existe pas.                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+int LireSchema(const char *nom)
+{
+
+    int i;
+
+    for (i = 0; i < NB_SCHEMAS; i++)
+    {
+        if (strcmp(nom, noms_schemas[i]) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int PreparerPlan(Plan *plan, int nb_annee)                      *
+ *                                                                            *
+ * Complète le plan choisi sur la ligne de commande : taille des blocs,       *
+ * tirages agrégés et nombre de tirages pilotés, et calcule les nombres de    *
+ * direction de la suite de Sobol si besoin.                                  *
+ *                                                                            *
+ * En entrée : Le plan, avec le schéma, la taille de bloc demandée (0 pour    *
+ *             la valeur par défaut) et le nombre d'années pilotées           *
+ *             Le nombre d'années simulées                                    *
+ *                                                                            *
+ * En sortie : 0 si le plan est utilisable                                    *
+ *             -1 sinon.                                                      *
+ *                                                                            *
+ ******************************************************************************/
+
+int PreparerPlan(Plan *plan, int nb_annee)
+{
+
+    int tirages;
+    ParametresSimu params;
+    Simulation *sim;
+
+    switch (plan->schema)
+    {
+    case SCHEMA_MC:
+        plan->taille_bloc = 1;
+        break;
+    case SCHEMA_ANTITHETIQUE:
+        plan->taille_bloc = 2;
+        break;
+    case SCHEMA_STRATIFIE:
+        if (plan->taille_bloc == 0)
+        {
+            plan->taille_bloc = 16;
+        }
+        break;
+    case SCHEMA_SOBOL:
+        if (plan->taille_bloc == 0)
+        {
+            plan->taille_bloc = 64;
+        }
+        //  Les propriétés d'équirépartition ne valent que pour 2^m points.
+        if (plan->taille_bloc & (plan->taille_bloc - 1))
+        {
+            return -1;
+        }
+        break;
+    default:
+        return -1;
+    }
+
+    if (plan->taille_bloc < 1 || plan->taille_bloc > 65536)
+    {
+        return -1;
+    }
+
+    //  Hors mc, il faut un nombre fixe de tirages par année : pour que les
+    //  deux répliques d'une paire antithétique restent alignées, et pour que
+    //  les tirages pilotés soient toujours les mêmes événements.
+    if (plan->schema != SCHEMA_MC)
+    {
+        plan->agreges = 1;
+    }
+
+    plan->dimension = 0;
+    if (plan->schema == SCHEMA_STRATIFIE || plan->schema == SCHEMA_SOBOL)
+    {
+        ParametresSimuDefaut(&params);
+        params.tirages_agreges = 1;
+        sim = SimulationCreer(&params);
+        if (sim == NULL)
+        {
+            return -1;
+        }
+        tirages = SimulationTiragesParAnnee(sim);
+        SimulationDetruire(sim);
+
+        if (plan->annees_plan < 1 || plan->annees_plan >= nb_annee ||
+            plan->annees_plan * tirages > SIMU_MAX_PREMIERS)
+        {
+            return -1;
+        }
+        plan->dimension = plan->annees_plan * tirages;
+    }
+    else
+    {
+        plan->annees_plan = 0;
+    }
+
+    if (plan->schema == SCHEMA_SOBOL)
+    {
+        InitDirectionsSobol(plan->dimension);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int GenererPlan(const Plan *plan, unsigned long graine,         *
+ *                            unsigned long long bloc, double *points)        *
+ *                                                                            *
+ * Calcule les tirages pilotés de toutes les répliques d'un bloc. Le hasard   *
+ * du plan vient d'un générateur propre au bloc, initialisé à partir de la    *
+ * graine et du numéro de bloc : le plan ne dépend pas du rang ni du thread   *
+ * qui simule le bloc.                                                        *
+ *                                                                            *
+ * En entrée : Le plan                                                        *
+ *             La graine commune de l'ensemble                                *
+ *             Le numéro du bloc                                              *
+ *             Le tableau à remplir, [Réplique du bloc][Tirage]               *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             -1 si la mémoire a manqué.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int GenererPlan(const Plan *plan, unsigned long graine, unsigned long long bloc, double *points)
+{
+
+    mt_state generateur;
+    unsigned long cle[6];
+
+    cle[0] = graine & 0xffffffffUL;
+    cle[1] = ((unsigned long long)graine >> 32) & 0xffffffffUL;
+    cle[2] = bloc & 0xffffffffUL;
+    cle[3] = (bloc >> 32) & 0xffffffffUL;
+    cle[4] = (unsigned long)plan->schema;
+    cle[5] = 0x706c616eUL;
+    init_by_array_r(&generateur, cle, 6);
+
+    if (plan->schema == SCHEMA_STRATIFIE)
+    {
+        return PlanStratifie(&generateur, plan->taille_bloc, plan->dimension, points);
+    }
+
+    PlanSobol(&generateur, plan->taille_bloc, plan->dimension, points);
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int PlanStratifie(mt_state *generateur, int taille_bloc,        *
+ *                              int dimension, double *points)                *
+ *                                                                            *
+ * Hypercube latin : pour chaque tirage, [0, 1] est coupé en taille_bloc      *
+ * strates de même largeur et chaque réplique du bloc reçoit un point         *
+ * uniforme dans une strate différente, l'attribution des strates étant une   *
+ * permutation aléatoire propre à chaque tirage.                              *
+ *                                                                            *
+ * En entrée : Le générateur du bloc                                          *
+ *             Le nombre de répliques du bloc                                 *
+ *             Le nombre de tirages pilotés par réplique                      *
+ *             Le tableau à remplir                                           *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             -1 si la mémoire a manqué.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int PlanStratifie(mt_state *generateur, int taille_bloc, int dimension, double *points)
+{
+
+    int j, s, k, echange;
+    int *strates = (int *)malloc(taille_bloc * sizeof(int));
+
+    if (strates == NULL)
+    {
+        return -1;
+    }
+
+    for (j = 0; j < dimension; j++)
+    {
+        //  Mélange de Fisher et Yates.
+        for (s = 0; s < taille_bloc; s++)
+        {
+            strates[s] = s;
+        }
+        for (s = taille_bloc - 1; s > 0; s--)
+        {
+            k = (int)(UniformeOuverte(generateur) * (s + 1));
+            echange = strates[s];
+            strates[s] = strates[k];
+            strates[k] = echange;
+        }
+
+        for (s = 0; s < taille_bloc; s++)
+        {
+            points[(size_t)s * dimension + j] = (strates[s] + UniformeOuverte(generateur)) / taille_bloc;
+        }
+    }
+
+    free(strates);
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void PlanSobol(mt_state *generateur, int taille_bloc,           *
+ *                           int dimension, double *points)                   *
+ *                                                                            *
+ * Donne aux répliques du bloc les taille_bloc premiers points de la suite de *
+ * Sobol, brouillés pour ce bloc : chaque coordonnée est multipliée par une   *
+ * matrice binaire triangulaire inférieure aléatoire de diagonale 1           *
+ * (brouillage de Matoušek), puis décalée par un ou exclusif aléatoire. Les   *
+ * points restent un réseau (t, m, s) et chacun est uniforme sur [0, 1]^d :   *
+ * la moyenne d'un bloc est sans biais.                                       *
+ *                                                                            *
+ * En entrée : Le générateur du bloc                                          *
+ *             Le nombre de répliques du bloc                                 *
+ *             Le nombre de tirages pilotés par réplique                      *
+ *             Le tableau à remplir                                           *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void PlanSobol(mt_state *generateur, int taille_bloc, int dimension, double *points)
+{
+
+    int j, k, r, s, i;
+    unsigned long lignes[BITS_SOBOL], brouilles[BITS_SOBOL], decalage, x, bit, masque;
+
+    for (j = 0; j < dimension; j++)
+    {
+        //  Ligne r de la matrice : le chiffre r (en partant du poids fort)
+        //  lui-même et des chiffres plus forts tirés au hasard.
+        for (r = 0; r < BITS_SOBOL; r++)
+        {
+            masque = r == 0 ? 0 : (0xffffffffUL << (BITS_SOBOL - r)) & 0xffffffffUL;
+            lignes[r] = (1UL << (BITS_SOBOL - 1 - r)) | (genrand_int32_r(generateur) & masque);
+        }
+
+        for (k = 0; k < BITS_SOBOL; k++)
+        {
+            brouilles[k] = 0;
+            for (r = 0; r < BITS_SOBOL; r++)
+            {
+                bit = (unsigned long)Parite(lignes[r] & directions_sobol[j][k]);
+                brouilles[k] |= bit << (BITS_SOBOL - 1 - r);
+            }
+        }
+
+        decalage = genrand_int32_r(generateur);
+
+        for (s = 0; s < taille_bloc; s++)
+        {
+            x = decalage;
+            for (i = s, k = 0; i != 0; i >>= 1, k++)
+            {
+                if (i & 1)
+                {
+                    x ^= brouilles[k];
+                }
+            }
+            points[(size_t)s * dimension + j] = (x + 0.5) / 4294967296.0;
+        }
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void InitDirectionsSobol(int dimension)                         *
+ *                                                                            *
+ * Calcule les nombres de direction des dimension premières coordonnées de la *
+ * suite de Sobol. La première est la suite de van der Corput, les suivantes  *
+ * utilisent les polynômes primitifs sur GF(2) par degré croissant, avec des  *
+ * nombres initiaux m_k impairs et inférieurs à 2^k tirés d'une graine fixe   *
+ * (comme le proposent Bratley et Fox) : la suite est la même d'une           *
+ * exécution à l'autre, seul son brouillage change.                           *
+ *                                                                            *
+ * En entrée : Le nombre de coordonnées (au plus SIMU_MAX_PREMIERS)           *
+ *                                                                            *
+ * En sortie : Rien, directions_sobol est rempli.                             *
+ *                                                                            *
+ ******************************************************************************/
+
+void InitDirectionsSobol(int dimension)
+{
+
+    int j, k, i, degre;
+    unsigned long long polynome, m[BITS_SOBOL + 1];
+    mt_state generateur;
+
+    init_genrand_r(&generateur, 5489UL);
+
+    for (k = 0; k < BITS_SOBOL; k++)
+    {
+        directions_sobol[0][k] = 1UL << (BITS_SOBOL - 1 - k);
+    }
+
+    //  Les polynômes de terme constant 1, rangés par valeur, le sont aussi par
+    //  degré.
+    for (j = 1, polynome = 3; j < dimension; polynome += 2)
+    {
+        degre = 0;
+        while (polynome >> (degre + 1) != 0)
+        {
+            degre++;
+        }
+
+        if (!PolynomePrimitif(polynome, degre))
+        {
+            continue;
+        }
+
+        for (k = 1; k <= degre && k <= BITS_SOBOL; k++)
+        {
+            m[k] = (genrand_int32_r(&generateur) & ((1ULL << k) - 1)) | 1;
+        }
+
+        //  Récurrence de Sobol sur les coefficients a_i du polynôme.
+        for (k = degre + 1; k <= BITS_SOBOL; k++)
+        {
+            m[k] = m[k - degre] ^ (m[k - degre] << degre);
+            for (i = 1; i < degre; i++)
+            {
+                if ((polynome >> (degre - i)) & 1)
+                {
+                    m[k] ^= m[k - i] << i;
+                }
+            }
+        }
+
+        for (k = 1; k <= BITS_SOBOL; k++)
+        {
+            directions_sobol[j][k - 1] = (unsigned long)((m[k] << (BITS_SOBOL - k)) & 0xffffffffULL);
+        }
+        j++;
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int PolynomePrimitif(unsigned long long polynome, int degre)    *
+ *                                                                            *
+ * Un polynôme de GF(2)[x] de degré d est primitif si x y est d'ordre         *
+ * 2^d - 1, c'est-à-dire si x^(2^d - 1) vaut 1 et si x^((2^d - 1) / q) ne     *
+ * vaut pas 1 pour chaque facteur premier q de 2^d - 1.                       *
+ *                                                                            *
+ * En entrée : Le polynôme (bit i = coefficient de x^i)                       *
+ *             Son degré                                                      *
+ *                                                                            *
+ * En sortie : 1 si le polynôme est primitif                                  *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int PolynomePrimitif(unsigned long long polynome, int degre)
+{
+
+    unsigned long long ordre = (1ULL << degre) - 1, reste = ordre, q;
+
+    if (PuissanceModulo(ordre, polynome, degre) != 1)
+    {
+        return 0;
+    }
+
+    for (q = 2; q * q <= reste; q++)
+    {
+        if (reste % q == 0)
+        {
+            if (PuissanceModulo(ordre / q, polynome, degre) == 1)
+            {
+                return 0;
+            }
+            while (reste % q == 0)
+            {
+                reste /= q;
+            }
+        }
+    }
+    if (reste > 1 && PuissanceModulo(ordre / reste, polynome, degre) == 1)
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonctions sur les polynômes de GF(2)[x] modulo un polynôme de degré        *
+ * degre : x^exposant par exponentiation rapide, et produit sans retenue      *
+ * suivi de la réduction.                                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+unsigned long long PuissanceModulo(unsigned long long exposant, unsigned long long polynome, int degre)
+{
+
+    unsigned long long resultat = 1, base = 2;
+
+    if ((base >> degre) & 1)
+    {
+        base ^= polynome;
+    }
+
+    while (exposant != 0)
+    {
+        if (exposant & 1)
+        {
+            resultat = ProduitModulo(resultat, base, polynome, degre);
+        }
+        base = ProduitModulo(base, base, polynome, degre);
+        exposant >>= 1;
+    }
+
+    return resultat;
+}
+
+unsigned long long ProduitModulo(unsigned long long a, unsigned long long b, unsigned long long polynome, int degre)
+{
+
+    unsigned long long resultat = 0;
+
+    while (b != 0)
+    {
+        if (b & 1)
+        {
+            resultat ^= a;
+        }
+        b >>= 1;
+        a <<= 1;
+        if ((a >> degre) & 1)
+        {
+            a ^= polynome;
+        }
+    }
+
+    return resultat;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int Parite(unsigned long x)                                     *
+ *                                                                            *
+ * En sortie : La parité du nombre de bits à 1 de x.                          *
+ *                                                                            *
+ ******************************************************************************/
+
+int Parite(unsigned long x)
+{
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+
+    return (int)(x & 1);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double UniformeOuverte(mt_state *generateur)                    *
+ *                                                                            *
+ * En sortie : Un nombre uniforme dans ]0, 1[ tiré de generateur.             *
+ *                                                                            *
+ ******************************************************************************/
+
+double UniformeOuverte(mt_state *generateur)
+{
+    return (genrand_int32_r(generateur) + 0.5) / 4294967296.0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonctions sur les entiers de 128 bits : addition avec retenue, produit de  *
+ * deux entiers de 64 bits par moitiés de 32 bits, conversion en flottant.    *
+ * Ajouter128 renvoie -1 si la somme dépasse 128 bits, 0 sinon.               *
+ *                                                                            *
+ ******************************************************************************/
+
+int Ajouter128(Entier128 *a, Entier128 b)
+{
+
+    unsigned long long retenue, haut = a->haut + b.haut;
+    int depassement = haut < b.haut;
+
+    a->bas += b.bas;
+    retenue = a->bas < b.bas;
+    a->haut = haut + retenue;
+
+    return depassement || a->haut < retenue ? -1 : 0;
+}
+
+Entier128 Produit64(unsigned long long x, unsigned long long y)
+{
+
+    Entier128 resultat;
+    unsigned long long x0 = x & 0xffffffffULL, x1 = x >> 32;
+    unsigned long long y0 = y & 0xffffffffULL, y1 = y >> 32;
+    unsigned long long p00 = x0 * y0, p01 = x0 * y1, p10 = x1 * y0, p11 = x1 * y1;
+    unsigned long long milieu = (p00 >> 32) + (p01 & 0xffffffffULL) + (p10 & 0xffffffffULL);
+
+    resultat.bas = (milieu << 32) | (p00 & 0xffffffffULL);
+    resultat.haut = p11 + (p01 >> 32) + (p10 >> 32) + (milieu >> 32);
+
+    return resultat;
+}
+
+long double VersFlottant(Entier128 a)
+{
+    return (long double)a.haut * 18446744073709551616.0L + (long double)a.bas;
+}
@@ -0,0 +1,380 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Programme : lecteur_lapin.c                                           *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Consulte un fichier de trajectoires écrit par ensemble_lapin -s (voir *
+ *      trajectoires.h) sans le parcourir : seules les années demandées sont  *
+ *      lues, quelle que soit la taille du fichier.                           *
+ *                                                                            *
+ *      Il se compile comme suit (voir simu_fin.c et trajectoires.h pour les  *
+ *      bibliothèques) :                                                      *
+ *      gcc -Wall -O2 lecteur_lapin.c -L. -lsimu_traj -lsimu_lapin -lm        *
+ *          -o lecteur_lapin                                                  *
+ *                                                                            *
+ *      Utilisation :                                                         *
+ *      ./lecteur_lapin traj.bin                 Description du fichier       *
+ *      ./lecteur_lapin traj.bin -r 12           Effectifs de chaque année de *
+ *                                               la réplique 12               *
+ *      ./lecteur_lapin traj.bin -r 12 -a 5      Tableau de l'année 5 de la   *
+ *                                               réplique 12, au format de    *
+ *                                               simu_fin.c                   *
+ *      ./lecteur_lapin traj.bin -a 5 -d 100 -n 20                            *
+ *                                               Population de l'année 5 des  *
+ *                                               répliques 100 à 119          *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "trajectoires.h"
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+void AfficheDescription(const Trajectoires *traj);
+
+int AfficheReplique(const Trajectoires *traj, unsigned long long replique, unsigned long long *enregistrement);
+
+int AfficheAnnee(const Trajectoires *traj, unsigned long long replique, int annee,
+                 unsigned long long *enregistrement);
+
+int AffichePopulations(const Trajectoires *traj, int annee, unsigned long long debut, unsigned long long nombre,
+                       unsigned long long *enregistrement);
+
+unsigned long long Total(const unsigned long long *ligne, int debut, int fin);
+
+/* -------------------------------------------------------------------------- */
+/*                         Fonction 'main' principale                         */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[])
+{
+
+    int option, annee = -1, erreur;
+    long long replique = -1;
+    unsigned long long debut, nombre = 0;
+    int debut_fixe = 0;
+    unsigned long long *enregistrement;
+    Trajectoires *traj;
+
+    while ((option = getopt(argc, argv, "r:a:d:n:")) != -1)
+    {
+        switch (option)
+        {
+        case 'r':
+            replique = atoll(optarg);
+            break;
+        case 'a':
+            annee = atoi(optarg);
+            break;
+        case 'd':
+            debut = strtoull(optarg, NULL, 10);
+            debut_fixe = 1;
+            break;
+        case 'n':
+            nombre = strtoull(optarg, NULL, 10);
+            break;
+        default:
+            fprintf(stderr, "Usage : %s <fichier> [-r réplique] [-a année] [-d première réplique -n nombre]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        fprintf(stderr, "Il faut un fichier de trajectoires\n");
+        return EXIT_FAILURE;
+    }
+
+    traj = TrajectoiresOuvrir(argv[optind]);
+    if (traj == NULL)
+    {
+        fprintf(stderr, "Fichier de trajectoires invalide : %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    enregistrement = (unsigned long long *)malloc(SIMU_NB_LIGNES * TrajectoiresAgeMax(traj) *
+                                                  sizeof(unsigned long long));
+    if (enregistrement == NULL)
+    {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        TrajectoiresFermer(traj);
+        return EXIT_FAILURE;
+    }
+
+    if (!debut_fixe)
+    {
+        debut = TrajectoiresPremiereReplique(traj);
+    }
+    if (nombre == 0)
+    {
+        nombre = TrajectoiresNbRepliques(traj);
+    }
+
+    if (replique >= 0 && annee >= 0)
+    {
+        erreur = AfficheAnnee(traj, (unsigned long long)replique, annee, enregistrement);
+    }
+    else if (replique >= 0)
+    {
+        erreur = AfficheReplique(traj, (unsigned long long)replique, enregistrement);
+    }
+    else if (annee >= 0)
+    {
+        erreur = AffichePopulations(traj, annee, debut, nombre, enregistrement);
+    }
+    else
+    {
+        AfficheDescription(traj);
+        erreur = SIMU_OK;
+    }
+
+    if (erreur != SIMU_OK)
+    {
+        fprintf(stderr, erreur == SIMU_ERREUR_FICHIER ? "Fichier de trajectoires corrompu\n"
+                                                      : "Réplique ou année absente du fichier\n");
+    }
+
+    free(enregistrement);
+    TrajectoiresFermer(traj);
+
+    return erreur == SIMU_OK ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                       Fonctions servant au programme                       */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void AfficheDescription(const Trajectoires *traj)               *
+ *                                                                            *
+ * Affiche l'en-tête du fichier : répliques contenues, nombre d'années, mode  *
+ * de stockage et taille des données.                                         *
+ *                                                                            *
+ * En entrée : Le fichier.                                                    *
+ *                                                                            *
+ * En sortie : Rien, cette fonction ne fait que de l'affichage.               *
+ *                                                                            *
+ ******************************************************************************/
+
+void AfficheDescription(const Trajectoires *traj)
+{
+
+    unsigned long long i, presentes = 0;
+    unsigned long long premiere = TrajectoiresPremiereReplique(traj), nb = TrajectoiresNbRepliques(traj);
+    long double brut = (long double)nb * TrajectoiresNbAnnees(traj) * SIMU_NB_LIGNES * TrajectoiresAgeMax(traj) *
+                       sizeof(unsigned long long);
+
+    //  On ne lit que l'index, pas les données.
+    for (i = 0; i < nb; i++)
+    {
+        presentes += TrajectoiresPresente(traj, premiere + i);
+    }
+
+    printf("Répliques : %llu à %llu (%llu écrites)\n", premiere, premiere + nb - 1, presentes);
+    printf("Années : %d    Classes d'âge : %d\n", TrajectoiresNbAnnees(traj), TrajectoiresAgeMax(traj));
+    printf("Stockage : %s\n", TrajectoiresCompression(traj) == TRAJ_DELTA ? "delta et varint" : "brut");
+    printf("Données : %llu octets (%.1Lf %% du brut)\n", TrajectoiresTailleDonnees(traj),
+           brut > 0 ? 100 * TrajectoiresTailleDonnees(traj) / brut : 0);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AfficheReplique(const Trajectoires *traj,                   *
+ *                  unsigned long long replique,                              *
+ *                  unsigned long long *enregistrement)                       *
+ *                                                                            *
+ * Affiche pour chaque année d'une réplique le nombre de femelles et de       *
+ * mâles d'au moins un an, les naissances et les morts.                       *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             Le numéro de la réplique                                       *
+ *             Un tableau de travail d'une année                              *
+ *                                                                            *
+ * En sortie : SIMU_OK ou le code d'erreur de TrajectoiresLire.               *
+ *                                                                            *
+ ******************************************************************************/
+
+int AfficheReplique(const Trajectoires *traj, unsigned long long replique, unsigned long long *enregistrement)
+{
+
+    int annee, erreur;
+    int age_max = TrajectoiresAgeMax(traj);
+    const unsigned long long *femelles = enregistrement + SIMU_FEMELLES * age_max,
+                             *femelles_mortes = enregistrement + SIMU_FEMELLES_MORTES * age_max,
+                             *males = enregistrement + SIMU_MALES * age_max,
+                             *males_morts = enregistrement + SIMU_MALES_MORTS * age_max;
+
+    if (!TrajectoiresPresente(traj, replique))
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    printf("Réplique %llu\n\n", replique);
+    printf("%6s %14s %14s %14s %14s\n", "Année", "Femelles", "Mâles", "Naissances", "Morts");
+
+    for (annee = 0; annee < TrajectoiresNbAnnees(traj); annee++)
+    {
+        erreur = TrajectoiresLire(traj, replique, annee, enregistrement);
+        if (erreur != SIMU_OK)
+        {
+            return erreur;
+        }
+
+        printf("%6d %14llu %14llu %14llu %14llu\n", annee, Total(femelles, 1, age_max), Total(males, 1, age_max),
+               femelles[0] + males[0], Total(femelles_mortes, 0, age_max) + Total(males_morts, 0, age_max));
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AfficheAnnee(const Trajectoires *traj,                      *
+ *                  unsigned long long replique, int annee,                   *
+ *                  unsigned long long *enregistrement)                       *
+ *                                                                            *
+ * Affiche une année d'une réplique sous la même forme que AfficheTableau     *
+ * dans simu_fin.c : une ligne par ligne du tableau, une colonne par âge.     *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             Le numéro de la réplique                                       *
+ *             L'année                                                        *
+ *             Un tableau de travail d'une année                              *
+ *                                                                            *
+ * En sortie : SIMU_OK ou le code d'erreur de TrajectoiresLire.               *
+ *                                                                            *
+ ******************************************************************************/
+
+int AfficheAnnee(const Trajectoires *traj, unsigned long long replique, int annee,
+                 unsigned long long *enregistrement)
+{
+
+    int j, k, erreur;
+    int age_max = TrajectoiresAgeMax(traj);
+
+    erreur = TrajectoiresLire(traj, replique, annee, enregistrement);
+    if (erreur != SIMU_OK)
+    {
+        return erreur;
+    }
+
+    printf("Année %d\n", annee);
+
+    for (j = 0; j < SIMU_NB_LIGNES; j++)
+    {
+        for (k = 0; k < age_max; k++)
+        {
+            printf("%11lld\t", enregistrement[j * age_max + k]);
+        }
+        printf("\n");
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AffichePopulations(const Trajectoires *traj, int annee,     *
+ *                  unsigned long long debut, unsigned long long nombre,      *
+ *                  unsigned long long *enregistrement)                       *
+ *                                                                            *
+ * Affiche la population (âge 1 et plus) d'une année pour une plage de        *
+ * répliques, en sautant celles qui n'ont pas été écrites.                    *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             L'année                                                        *
+ *             La première réplique et le nombre de répliques                 *
+ *             Un tableau de travail d'une année                              *
+ *                                                                            *
+ * En sortie : SIMU_OK, ou le code d'erreur de TrajectoiresLire si le fichier *
+ *             est corrompu ou si l'année n'existe pas.                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int AffichePopulations(const Trajectoires *traj, int annee, unsigned long long debut, unsigned long long nombre,
+                       unsigned long long *enregistrement)
+{
+
+    int erreur;
+    int age_max = TrajectoiresAgeMax(traj);
+    unsigned long long replique;
+
+    if (annee >= TrajectoiresNbAnnees(traj))
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    printf("%12s %14s\n", "Réplique", "Population");
+
+    for (replique = debut; replique < debut + nombre; replique++)
+    {
+        if (!TrajectoiresPresente(traj, replique))
+        {
+            continue;
+        }
+
+        erreur = TrajectoiresLire(traj, replique, annee, enregistrement);
+        if (erreur != SIMU_OK)
+        {
+            return erreur;
+        }
+
+        printf("%12llu %14llu\n", replique,
+               Total(enregistrement + SIMU_FEMELLES * age_max, 1, age_max) +
+               Total(enregistrement + SIMU_MALES * age_max, 1, age_max));
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : unsigned long long Total(const unsigned long long *ligne,       *
+ *                                     int debut, int fin)                    *
+ *                                                                            *
+ * En sortie : La somme des cases debut à fin - 1 d'une ligne.                *
+ *                                                                            *
+ ******************************************************************************/
+
+unsigned long long Total(const unsigned long long *ligne, int debut, int fin)
+{
+
+    int i;
+    unsigned long long total = 0;
+
+    for (i = debut; i < fin; i++)
+    {
+        total += ligne[i];
+    }
+
+    return total;
+}
@@ -42,20 +42,24 @@
 */
 
 #include <stdio.h>
+#include "mt19937ar.h"
 
 /* Period parameters */  
-#define N 624
+#define N MT_N
 #define M 397
 #define MATRIX_A 0x9908b0dfUL   /* constant vector a */
 #define UPPER_MASK 0x80000000UL /* most significant w-r bits */
 #define LOWER_MASK 0x7fffffffUL /* least significant r bits */
 
-static unsigned long mt[N]; /* the array for the state vector  */
-static int mti=N+1; /* mti==N+1 means mt[N] is not initialized */
+/* global state used by the historical non-reentrant interface */
+static mt_state etat_global = { {0}, N+1 }; /* mti==N+1 means mt[N] is not initialized */
 
 /* initializes mt[N] with a seed */
-void init_genrand(unsigned long s)
+void init_genrand_r(mt_state *etat, unsigned long s)
 {
+    unsigned long *mt = etat->mt;
+    int mti;
+
     mt[0]= s & 0xffffffffUL;
     for (mti=1; mti<N; mti++) {
         mt[mti] = 
@@ -67,16 +71,18 @@ void init_genrand(unsigned long s)
         mt[mti] &= 0xffffffffUL;
         /* for >32 bit machines */
     }
+    etat->mti = mti;
 }
 
 /* initialize by an array with array-length */
 /* init_key is the array for initializing keys */
 /* key_length is its length */
 /* slight change for C++, 2004/2/26 */
-void init_by_array(unsigned long init_key[], int key_length)
+void init_by_array_r(mt_state *etat, unsigned long init_key[], int key_length)
 {
+    unsigned long *mt = etat->mt;
     int i, j, k;
-    init_genrand(19650218UL);
+    init_genrand_r(etat, 19650218UL);
     i=1; j=0;
     k = (N>key_length ? N : key_length);
     for (; k; k--) {
@@ -99,17 +105,18 @@ void init_by_array(unsigned long init_key[], int key_length)
 }
 
 /* generates a random number on [0,0xffffffff]-interval */
-unsigned long genrand_int32(void)
+unsigned long genrand_int32_r(mt_state *etat)
 {
+    unsigned long *mt = etat->mt;
     unsigned long y;
-    static unsigned long mag01[2]={0x0UL, MATRIX_A};
+    static const unsigned long mag01[2]={0x0UL, MATRIX_A};
     /* mag01[x] = x * MATRIX_A  for x=0,1 */
 
-    if (mti >= N) { /* generate N words at one time */
+    if (etat->mti >= N) { /* generate N words at one time */
         int kk;
 
-        if (mti == N+1)   /* if init_genrand() has not been called, */
-            init_genrand(5489UL); /* a default initial seed is used */
+        if (etat->mti == N+1)   /* if init_genrand() has not been called, */
+            init_genrand_r(etat, 5489UL); /* a default initial seed is used */
 
         for (kk=0;kk<N-M;kk++) {
             y = (mt[kk]&UPPER_MASK)|(mt[kk+1]&LOWER_MASK);
@@ -122,10 +129,10 @@ unsigned long genrand_int32(void)
         y = (mt[N-1]&UPPER_MASK)|(mt[0]&LOWER_MASK);
         mt[N-1] = mt[M-1] ^ (y >> 1) ^ mag01[y & 0x1UL];
 
-        mti = 0;
+        etat->mti = 0;
     }
   
-    y = mt[mti++];
+    y = mt[etat->mti++];
 
     /* Tempering */
     y ^= (y >> 11);
@@ -136,6 +143,29 @@ unsigned long genrand_int32(void)
     return y;
 }
 
+/* generates a random number on [0,1]-real-interval */
+double genrand_real1_r(mt_state *etat)
+{
+    return genrand_int32_r(etat)*(1.0/4294967295.0); 
+    /* divided by 2^32-1 */ 
+}
+
+/* historical interface, working on the global state */
+void init_genrand(unsigned long s)
+{
+    init_genrand_r(&etat_global, s);
+}
+
+void init_by_array(unsigned long init_key[], int key_length)
+{
+    init_by_array_r(&etat_global, init_key, key_length);
+}
+
+unsigned long genrand_int32(void)
+{
+    return genrand_int32_r(&etat_global);
+}
+
 /* generates a random number on [0,0x7fffffff]-interval */
 long genrand_int31(void)
 {
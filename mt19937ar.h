@@ -0,0 +1,38 @@
+/*
+   Interface of the MT19937 generator (see mt19937ar.c for the copyright
+   notice of Makoto Matsumoto and Takuji Nishimura).
+
+   The historical functions (init_genrand, genrand_real1, ...) work on a
+   single global state. The "_r" variants work on a state owned by the
+   caller, so that several independent streams can coexist in the same
+   process (one per simulation for instance).
+*/
+
+#ifndef MT19937AR_H
+#define MT19937AR_H
+
+#define MT_N 624
+
+typedef struct mt_state
+{
+    unsigned long mt[MT_N]; /* the array for the state vector  */
+    int mti;                /* mti==MT_N+1 means mt[MT_N] is not initialized */
+} mt_state;
+
+/* reentrant interface */
+void init_genrand_r(mt_state *etat, unsigned long s);
+void init_by_array_r(mt_state *etat, unsigned long init_key[], int key_length);
+unsigned long genrand_int32_r(mt_state *etat);
+double genrand_real1_r(mt_state *etat);
+
+/* historical interface, on the global state */
+void init_genrand(unsigned long s);
+void init_by_array(unsigned long init_key[], int key_length);
+unsigned long genrand_int32(void);
+long genrand_int31(void);
+double genrand_real1(void);
+double genrand_real2(void);
+double genrand_real3(void);
+double genrand_res53(void);
+
+#endif
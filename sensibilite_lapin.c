@@ -0,0 +1,704 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Programme : sensibilite_lapin.c                                       *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Mesure la sensibilité de la population de la dernière année aux       *
+ *      paramètres du modèle (survie des bébés et des adultes, sénescence,    *
+ *      sexe des bébés, répartition des portées). Pour chaque paramètre, on   *
+ *      donne deux estimations de la dérivée de la population moyenne, avec   *
+ *      leur intervalle de confiance à 95 % :                                 *
+ *                                                                            *
+ *      - une différence finie centrée avec nombres aléatoires communs        *
+ *        (DF-NAC) : chaque réplique est simulée avec le paramètre augmenté   *
+ *        puis diminué d'un petit pas, avec les mêmes nombres aléatoires      *
+ *        pour les mêmes événements (voir flux_communs dans simu_lapin.h) ;   *
+ *      - un rapport de vraisemblance (RV) : la dérivée est la covariance     *
+ *        entre la population finale et la dérivée de la log-vraisemblance    *
+ *        de la trajectoire, calculée à partir d'une seule simulation.        *
+ *                                                                            *
+ *      La colonne « Gain NAC » donne le facteur de réduction de variance     *
+ *      obtenu par rapport à deux simulations indépendantes : il faudrait     *
+ *      autant de fois plus de répliques sans nombres aléatoires communs.     *
+ *                                                                            *
+ *      La survie d'un adulte, survie_adulte moins la sénescence, est bornée  *
+ *      à 0 : à l'âge où elle s'annule (l'âge 15 avec les valeurs par         *
+ *      défaut), elle n'est pas dérivable. Le rapport de vraisemblance ne     *
+ *      voit pas cet âge, où tous les lapins meurent quel que soit le         *
+ *      paramètre, alors que la différence finie passe de part et d'autre du  *
+ *      coude et en mesure la moitié de la pente. Les deux estimations ne     *
+ *      portent donc plus sur la même quantité : le programme marque d'une    *
+ *      « * » les paramètres concernés et donne l'âge du coude sous le        *
+ *      tableau.                                                              *
+ *                                                                            *
+ *      Il se compile comme suit (voir simu_fin.c pour la bibliothèque) :     *
+ *      gcc -Wall -O2 -fopenmp sensibilite_lapin.c -L. -lsimu_lapin -lm       *
+ *          -o sensibilite_lapin                                              *
+ *      Puis, par exemple :                                                   *
+ *      ./sensibilite_lapin -r 2000 -a 8 survie_adulte repartition_portee[2]  *
+ *                                                                            *
+ *      Options :                                                             *
+ *      -r <n>   Nombre de répliques                                          *
+ *      -a <n>   Nombre d'années simulées (année 0 comprise, 8 par défaut)    *
+ *      -g <n>   Graine commune (5489 par défaut)                             *
+ *      -e <x>   Pas relatif des différences finies (0.01 par défaut)         *
+ *      -t <n>   Nombre de threads                                            *
+ *      Les paramètres à étudier suivent les options, tous par défaut.        *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <unistd.h>
+#include <omp.h>
+
+#include "simu_lapin.h"
+
+/* -------------------------------------------------------------------------- */
+/*                                Constantes                                  */
+/* -------------------------------------------------------------------------- */
+
+#define MAX_PARAMETRES 32
+#define Z_95 1.959963984540054
+
+//  En dessous de cet écart, une survie est considérée comme valant 0 ou 1 :
+//  0.6 - 6 * 0.1 ne tombe pas toujours exactement sur 0.
+#define EPSILON_SURVIE 1e-12
+
+/* -------------------------------------------------------------------------- */
+/*                                  Types                                     */
+/* -------------------------------------------------------------------------- */
+
+//  Les paramètres étudiés sont tous des probabilités (de type double), on
+//  les repère par leur position dans ParametresSimu.
+typedef enum TypeParametre
+{
+    SURVIE_PETIT,
+    SURVIE_ADULTE,
+    DECROISSANCE,
+    PROBA_FEMELLE,
+    REPARTITION
+} TypeParametre;
+
+typedef struct Parametre
+{
+    char nom[64];
+    TypeParametre type;
+    size_t decalage;
+    int classe; // Classe de portées, pour REPARTITION
+    double pas;
+} Parametre;
+
+//  Résultats d'une réplique, rangés par paramètre.
+typedef struct Resultats
+{
+    double *population;
+    double *score[MAX_PARAMETRES];
+    double *plus[MAX_PARAMETRES];
+    double *moins[MAX_PARAMETRES];
+} Resultats;
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+int LireParametre(const char *nom, const ParametresSimu *base, double pas_relatif, Parametre *parametre);
+
+int SimulerReplique(const ParametresSimu *params, unsigned long long replique, int nb_annee,
+                    const Parametre *parametres, int nb_parametres, double *population, double *scores);
+
+double Score(const Simulation *sim, const ParametresSimu *params, const Parametre *parametre, int nb_annee);
+
+double ScoreBernoulli(unsigned long long vivants, unsigned long long morts, double survie, double derivee);
+
+int AgeCoude(const ParametresSimu *base, const Parametre *parametre);
+
+double SurvieAdulte(const ParametresSimu *params, int age);
+
+double PopulationAnnee(const Simulation *sim, int annee);
+
+void Moyenne(const double *valeurs, unsigned long long n, double *moyenne, double *variance);
+
+/* -------------------------------------------------------------------------- */
+/*                         Fonction 'main' principale                         */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char *argv[])
+{
+
+    int option, p, nb_parametres = 0, nb_annee = 8, erreur = 0, coude;
+    unsigned long long i, nb_repliques = 0;
+    double pas_relatif = 0.01;
+    double moyenne_y, variance_y, moyenne_s, variance_s, moyenne, variance, variance_df;
+    double moyenne_plus, variance_plus, moyenne_moins, variance_moins;
+    double *differences, *produits;
+    const char *defauts[] = {"survie_petit", "survie_adulte", "decroissance_senescence", "proba_femelle",
+                             "repartition_portee[0]", "repartition_portee[1]", "repartition_portee[2]",
+                             "repartition_portee[3]"};
+    const char **noms = defauts;
+    int nb_noms = sizeof(defauts) / sizeof(defauts[0]);
+    ParametresSimu base;
+    Parametre parametres[MAX_PARAMETRES];
+    Resultats resultats;
+
+    ParametresSimuDefaut(&base);
+    base.flux_communs = 1;
+
+    while ((option = getopt(argc, argv, "r:a:g:e:t:")) != -1)
+    {
+        switch (option)
+        {
+        case 'r':
+            nb_repliques = strtoull(optarg, NULL, 10);
+            break;
+        case 'a':
+            nb_annee = atoi(optarg);
+            break;
+        case 'g':
+            base.graine = strtoul(optarg, NULL, 10);
+            break;
+        case 'e':
+            pas_relatif = atof(optarg);
+            break;
+        case 't':
+            omp_set_num_threads(atoi(optarg));
+            break;
+        default:
+            fprintf(stderr, "Usage : %s -r <répliques> [-a années] [-g graine] [-e pas] [-t threads] [paramètres...]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (nb_repliques < 2 || nb_annee < 2 || pas_relatif <= 0)
+    {
+        fprintf(stderr, "Il faut au moins deux répliques, deux années et un pas positif\n");
+        return EXIT_FAILURE;
+    }
+
+    //  On lit les paramètres à étudier, ou on les prend tous.
+    if (optind < argc)
+    {
+        noms = (const char **)argv + optind;
+        nb_noms = argc - optind;
+    }
+
+    for (p = 0; p < nb_noms; p++)
+    {
+        if (nb_parametres == MAX_PARAMETRES ||
+            !LireParametre(noms[p], &base, pas_relatif, &parametres[nb_parametres]))
+        {
+            fprintf(stderr, "Paramètre inconnu ou trop de paramètres : %s\n", noms[p]);
+            return EXIT_FAILURE;
+        }
+        nb_parametres++;
+    }
+
+    resultats.population = (double *)malloc(nb_repliques * sizeof(double));
+    differences = (double *)malloc(nb_repliques * sizeof(double));
+    produits = (double *)malloc(nb_repliques * sizeof(double));
+    erreur = resultats.population == NULL || differences == NULL || produits == NULL;
+
+    for (p = 0; p < nb_parametres && !erreur; p++)
+    {
+        resultats.score[p] = (double *)malloc(nb_repliques * sizeof(double));
+        resultats.plus[p] = (double *)malloc(nb_repliques * sizeof(double));
+        resultats.moins[p] = (double *)malloc(nb_repliques * sizeof(double));
+        erreur = resultats.score[p] == NULL || resultats.plus[p] == NULL || resultats.moins[p] == NULL;
+    }
+
+    if (erreur)
+    {
+        fprintf(stderr, "Mémoire insuffisante\n");
+        return EXIT_FAILURE;
+    }
+
+    //  Chaque réplique est simulée une fois avec les paramètres de base (pour
+    //  le rapport de vraisemblance) puis deux fois par paramètre étudié.
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i = 0; i < nb_repliques; i++)
+    {
+        int q, echec;
+        double scores[MAX_PARAMETRES];
+        ParametresSimu modifies;
+
+        echec = SimulerReplique(&base, i, nb_annee, parametres, nb_parametres,
+                                &resultats.population[i], scores);
+
+        for (q = 0; q < nb_parametres && !echec; q++)
+        {
+            resultats.score[q][i] = scores[q];
+
+            modifies = base;
+            *(double *)((char *)&modifies + parametres[q].decalage) += parametres[q].pas;
+            echec |= SimulerReplique(&modifies, i, nb_annee, NULL, 0, &resultats.plus[q][i], NULL);
+
+            modifies = base;
+            *(double *)((char *)&modifies + parametres[q].decalage) -= parametres[q].pas;
+            echec |= SimulerReplique(&modifies, i, nb_annee, NULL, 0, &resultats.moins[q][i], NULL);
+        }
+
+        if (echec)
+        {
+#pragma omp atomic write
+            erreur = 1;
+        }
+    }
+
+    if (erreur)
+    {
+        fprintf(stderr, "Échec d'une simulation (mémoire ou paramètre perturbé invalide)\n");
+        return EXIT_FAILURE;
+    }
+
+    Moyenne(resultats.population, nb_repliques, &moyenne_y, &variance_y);
+
+    printf("Répliques : %llu    Année : %d    Population moyenne : %.3f ± %.3f\n\n",
+           nb_repliques, nb_annee - 1, moyenne_y, Z_95 * sqrt(variance_y / nb_repliques));
+    printf("%-24s %8s %10s %14s %12s %14s %12s %10s\n",
+           "Paramètre", "Valeur", "Pas", "DF-NAC", "IC 95 %", "RV", "IC 95 %", "Gain NAC");
+
+    for (p = 0; p < nb_parametres; p++)
+    {
+        //  Différence finie centrée, réplique par réplique.
+        for (i = 0; i < nb_repliques; i++)
+        {
+            differences[i] = (resultats.plus[p][i] - resultats.moins[p][i]) / (2 * parametres[p].pas);
+        }
+        Moyenne(differences, nb_repliques, &moyenne, &variance_df);
+        Moyenne(resultats.plus[p], nb_repliques, &moyenne_plus, &variance_plus);
+        Moyenne(resultats.moins[p], nb_repliques, &moyenne_moins, &variance_moins);
+
+        printf("%-24s %8.4f %10.6f %14.3f%c%12.3f", parametres[p].nom,
+               *(double *)((char *)&base + parametres[p].decalage), parametres[p].pas,
+               moyenne, AgeCoude(&base, &parametres[p]) > 0 ? '*' : ' ', Z_95 * sqrt(variance_df / nb_repliques));
+
+        //  Rapport de vraisemblance : covariance empirique entre la
+        //  population et le score, centrée pour réduire sa variance.
+        Moyenne(resultats.score[p], nb_repliques, &moyenne_s, &variance_s);
+        for (i = 0; i < nb_repliques; i++)
+        {
+            produits[i] = (resultats.population[i] - moyenne_y) * (resultats.score[p][i] - moyenne_s);
+        }
+        Moyenne(produits, nb_repliques, &moyenne, &variance);
+
+        printf(" %14.3f %12.3f", moyenne * nb_repliques / (nb_repliques - 1),
+               Z_95 * sqrt(variance / nb_repliques));
+
+        //  Var(Y+) + Var(Y-) est la variance qu'aurait Y+ - Y- avec deux
+        //  simulations indépendantes.
+        variance_df *= 4 * parametres[p].pas * parametres[p].pas;
+        if (variance_df > 0)
+        {
+            printf(" %10.1f\n", (variance_plus + variance_moins) / variance_df);
+        }
+        else
+        {
+            printf(" %10s\n", "infini");
+        }
+    }
+
+    for (p = 0; p < nb_parametres; p++)
+    {
+        coude = AgeCoude(&base, &parametres[p]);
+        if (coude > 0)
+        {
+            printf("\n* %s : la survie des adultes s'annule à l'âge %d, où elle n'est pas dérivable.\n"
+                   "  DF-NAC y mesure la moyenne des dérivées à gauche et à droite, RV n'en tient pas compte.\n",
+                   parametres[p].nom, coude);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                       Fonctions servant au programme                       */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int LireParametre(const char *nom, const ParametresSimu *base,  *
+ *                              double pas_relatif, Parametre *parametre)     *
+ *                                                                            *
+ * Reconnaît un paramètre étudiable et calcule le pas de ses différences      *
+ * finies, proportionnel à sa valeur de base.                                 *
+ *                                                                            *
+ * En entrée : Le nom du paramètre                                            *
+ *             Les paramètres de base                                         *
+ *             Le pas relatif                                                 *
+ *             La description du paramètre à remplir                          *
+ *                                                                            *
+ * En sortie : 1 si le paramètre est reconnu                                  *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int LireParametre(const char *nom, const ParametresSimu *base, double pas_relatif, Parametre *parametre)
+{
+
+    char fin;
+
+    if (strcmp(nom, "survie_petit") == 0)
+    {
+        parametre->type = SURVIE_PETIT;
+        parametre->decalage = offsetof(ParametresSimu, survie_petit);
+    }
+    else if (strcmp(nom, "survie_adulte") == 0)
+    {
+        parametre->type = SURVIE_ADULTE;
+        parametre->decalage = offsetof(ParametresSimu, survie_adulte);
+    }
+    else if (strcmp(nom, "decroissance_senescence") == 0)
+    {
+        parametre->type = DECROISSANCE;
+        parametre->decalage = offsetof(ParametresSimu, decroissance_senescence);
+    }
+    else if (strcmp(nom, "proba_femelle") == 0)
+    {
+        parametre->type = PROBA_FEMELLE;
+        parametre->decalage = offsetof(ParametresSimu, proba_femelle);
+    }
+    else if (sscanf(nom, "repartition_portee[%d%c", &parametre->classe, &fin) == 2 && fin == ']' &&
+             parametre->classe >= 0 && parametre->classe < base->nb_classes_portee - 1)
+    {
+        //  La dernière classe cumulée vaut toujours 1, elle n'est pas étudiable.
+        parametre->type = REPARTITION;
+        parametre->decalage = offsetof(ParametresSimu, repartition_portee) + parametre->classe * sizeof(double);
+    }
+    else
+    {
+        return 0;
+    }
+
+    strncpy(parametre->nom, nom, sizeof(parametre->nom) - 1);
+    parametre->nom[sizeof(parametre->nom) - 1] = '\0';
+    parametre->pas = pas_relatif * *(const double *)((const char *)base + parametre->decalage);
+
+    return parametre->pas > 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulerReplique(const ParametresSimu *params,               *
+ *                  unsigned long long replique, int nb_annee,                *
+ *                  const Parametre *parametres, int nb_parametres,           *
+ *                  double *population, double *scores)                       *
+ *                                                                            *
+ * Simule une réplique avec les conditions initiales de simu_fin.c et donne   *
+ * sa population à la dernière année. Si des paramètres sont donnés, calcule  *
+ * aussi le score (dérivée de la log-vraisemblance) de la trajectoire pour    *
+ * chacun d'eux.                                                              *
+ *                                                                            *
+ * En entrée : Les paramètres du modèle                                       *
+ *             Le numéro de la réplique                                       *
+ *             Le nombre d'années (année 0 comprise)                          *
+ *             Les paramètres étudiés et leur nombre (NULL et 0 si aucun)     *
+ *             La population à remplir                                        *
+ *             Les scores à remplir                                           *
+ *                                                                            *
+ * En sortie : 0 si tout s'est bien passé                                     *
+ *             1 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulerReplique(const ParametresSimu *params, unsigned long long replique, int nb_annee,
+                    const Parametre *parametres, int nb_parametres, double *population, double *scores)
+{
+
+    int p;
+    Simulation *sim = SimulationCreerReplique(params, replique);
+
+    if (sim == NULL)
+    {
+        return 1;
+    }
+
+    SimulationPeupler(sim, SIMU_FEMELLES, 10, 10);
+    SimulationPeupler(sim, SIMU_MALES, 10, 10);
+
+    if (SimulationAvancer(sim, nb_annee - 1) != SIMU_OK)
+    {
+        SimulationDetruire(sim);
+        return 1;
+    }
+
+    *population = PopulationAnnee(sim, nb_annee - 1);
+
+    for (p = 0; p < nb_parametres; p++)
+    {
+        scores[p] = Score(sim, params, &parametres[p], nb_annee);
+    }
+
+    SimulationDetruire(sim);
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double Score(const Simulation *sim,                             *
+ *                         const ParametresSimu *params,                      *
+ *                         const Parametre *parametre, int nb_annee)          *
+ *                                                                            *
+ * Calcule la dérivée, par rapport à un paramètre, du logarithme de la        *
+ * probabilité de la trajectoire. Elle ne dépend que des comptes de la        *
+ * trajectoire : bébés et adultes morts ou survivants, sexe des bébés et      *
+ * nombre de portées de chaque lapine.                                        *
+ *                                                                            *
+ * Pour un paramètre de répartition des portées, augmenter la valeur cumulée  *
+ * de la classe i revient à rendre la classe i plus probable et la classe     *
+ * i + 1 moins probable, d'autant.                                            *
+ *                                                                            *
+ * En entrée : La trajectoire                                                 *
+ *             Les paramètres avec lesquels elle a été simulée                *
+ *             Le paramètre étudié                                            *
+ *             Le nombre d'années (année 0 comprise)                          *
+ *                                                                            *
+ * En sortie : Le score de la trajectoire.                                    *
+ *                                                                            *
+ ******************************************************************************/
+
+double Score(const Simulation *sim, const ParametresSimu *params, const Parametre *parametre, int nb_annee)
+{
+
+    int annee, sexe, age;
+    double score = 0, decroissance, proba_classe, proba_suivante;
+    const unsigned long long *vivants, *morts, *portees;
+    int lignes_vivants[2] = {SIMU_FEMELLES, SIMU_MALES};
+    int lignes_morts[2] = {SIMU_FEMELLES_MORTES, SIMU_MALES_MORTS};
+
+    //  La dernière année n'a ni naissances ni morts calculées.
+    for (annee = 0; annee < nb_annee - 1; annee++)
+    {
+        switch (parametre->type)
+        {
+        case PROBA_FEMELLE:
+            score += ScoreBernoulli(SimulationCohorte(sim, annee, SIMU_FEMELLES)[0] +
+                                        SimulationCohorte(sim, annee, SIMU_MALES)[0],
+                                    SimulationCohorte(sim, annee, SIMU_MALES)[0], params->proba_femelle, 1);
+            break;
+
+        case REPARTITION:
+            portees = SimulationPortees(sim, annee);
+            proba_classe = params->repartition_portee[parametre->classe] -
+                           (parametre->classe > 0 ? params->repartition_portee[parametre->classe - 1] : 0);
+            proba_suivante = params->repartition_portee[parametre->classe + 1] -
+                             params->repartition_portee[parametre->classe];
+            if (proba_classe > 0)
+            {
+                score += portees[parametre->classe] / proba_classe;
+            }
+            if (proba_suivante > 0)
+            {
+                score -= portees[parametre->classe + 1] / proba_suivante;
+            }
+            break;
+
+        default:
+            for (sexe = 0; sexe < 2; sexe++)
+            {
+                vivants = SimulationCohorte(sim, annee, lignes_vivants[sexe]);
+                morts = SimulationCohorte(sim, annee, lignes_morts[sexe]);
+
+                if (parametre->type == SURVIE_PETIT)
+                {
+                    score += ScoreBernoulli(vivants[0], morts[0], params->survie_petit, 1);
+                    continue;
+                }
+
+                //  Même calcul de la survie que dans Mortalite.
+                decroissance = 0;
+                for (age = 1; age < params->age_max; age++)
+                {
+                    if (age >= params->age_senescence)
+                    {
+                        decroissance += params->decroissance_senescence;
+                    }
+
+                    if (parametre->type == SURVIE_ADULTE)
+                    {
+                        score += ScoreBernoulli(vivants[age], morts[age], params->survie_adulte - decroissance, 1);
+                    }
+                    else if (age >= params->age_senescence)
+                    {
+                        score += ScoreBernoulli(vivants[age], morts[age], params->survie_adulte - decroissance,
+                                                -(age - params->age_senescence + 1));
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    return score;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double ScoreBernoulli(unsigned long long vivants,               *
+ *                                  unsigned long long morts, double survie,  *
+ *                                  double derivee)                           *
+ *                                                                            *
+ * Score de vivants tirages de survie de probabilité survie, dont morts ont   *
+ * échoué, quand la dérivée de survie par rapport au paramètre vaut derivee.  *
+ * Les probabilités de 0 ou 1 donnent un résultat certain, donc un score nul. *
+ * C'est aussi le cas d'une survie qui ne vaut 0 qu'aux erreurs d'arrondi     *
+ * près : le coude qu'elle y fait est exclu du rapport de vraisemblance (voir *
+ * AgeCoude).                                                                 *
+ *                                                                            *
+ ******************************************************************************/
+
+double ScoreBernoulli(unsigned long long vivants, unsigned long long morts, double survie, double derivee)
+{
+    if (survie <= EPSILON_SURVIE || survie >= 1 - EPSILON_SURVIE || vivants == 0)
+    {
+        return 0;
+    }
+
+    return derivee * ((double)(vivants - morts) / survie - (double)morts / (1 - survie));
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AgeCoude(const ParametresSimu *base,                        *
+ *                         const Parametre *parametre)                        *
+ *                                                                            *
+ * Cherche un âge où la survie des adultes passe par 0 entre les deux         *
+ * simulations de la différence finie (paramètre diminué puis augmenté du     *
+ * pas). La survie y est bornée, donc non dérivable, et la différence finie   *
+ * n'estime plus la même chose que le rapport de vraisemblance.               *
+ *                                                                            *
+ * En entrée : Les paramètres de base                                         *
+ *             Le paramètre étudié                                            *
+ *                                                                            *
+ * En sortie : Le premier âge concerné                                        *
+ *             -1 s'il n'y en a pas ou si le paramètre ne touche pas la       *
+ *             survie des adultes.                                            *
+ *                                                                            *
+ ******************************************************************************/
+
+int AgeCoude(const ParametresSimu *base, const Parametre *parametre)
+{
+
+    int age;
+    ParametresSimu plus = *base, moins = *base;
+
+    if (parametre->type != SURVIE_ADULTE && parametre->type != DECROISSANCE)
+    {
+        return -1;
+    }
+
+    *(double *)((char *)&plus + parametre->decalage) += parametre->pas;
+    *(double *)((char *)&moins + parametre->decalage) -= parametre->pas;
+
+    for (age = 1; age < base->age_max; age++)
+    {
+        if ((SurvieAdulte(&plus, age) > EPSILON_SURVIE) != (SurvieAdulte(&moins, age) > EPSILON_SURVIE))
+        {
+            return age;
+        }
+    }
+
+    return -1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double SurvieAdulte(const ParametresSimu *params, int age)      *
+ *                                                                            *
+ * En sortie : La probabilité de survie d'un adulte de cet âge, calculée      *
+ *             comme dans Mortalite (avant d'être bornée par le tirage).      *
+ *                                                                            *
+ ******************************************************************************/
+
+double SurvieAdulte(const ParametresSimu *params, int age)
+{
+
+    int i;
+    double decroissance = 0;
+
+    for (i = params->age_senescence; i <= age; i++)
+    {
+        decroissance += params->decroissance_senescence;
+    }
+
+    return params->survie_adulte - decroissance;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double PopulationAnnee(const Simulation *sim, int annee)        *
+ *                                                                            *
+ * En sortie : Le nombre de lapins présents au début de l'année (âge 1 et     *
+ *             plus), comme dans ensemble_lapin.c.                            *
+ *                                                                            *
+ ******************************************************************************/
+
+double PopulationAnnee(const Simulation *sim, int annee)
+{
+
+    int age;
+    unsigned long long population = 0;
+    const unsigned long long *femelles = SimulationCohorte(sim, annee, SIMU_FEMELLES);
+    const unsigned long long *males = SimulationCohorte(sim, annee, SIMU_MALES);
+
+    for (age = 1; age < SimulationAgeMax(sim); age++)
+    {
+        population += femelles[age] + males[age];
+    }
+
+    return (double)population;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void Moyenne(const double *valeurs, unsigned long long n,       *
+ *                         double *moyenne, double *variance)                 *
+ *                                                                            *
+ * Calcule la moyenne et la variance empirique (non biaisée) de n valeurs,    *
+ * en une passe avec la méthode de Welford.                                   *
+ *                                                                            *
+ ******************************************************************************/
+
+void Moyenne(const double *valeurs, unsigned long long n, double *moyenne, double *variance)
+{
+
+    unsigned long long i;
+    double delta, m = 0, m2 = 0;
+
+    for (i = 0; i < n; i++)
+    {
+        delta = valeurs[i] - m;
+        m += delta / (i + 1);
+        m2 += delta * (valeurs[i] - m);
+    }
+
+    *moyenne = m;
+    *variance = n > 1 ? m2 / (n - 1) : 0;
+}
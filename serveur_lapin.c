@@ -0,0 +1,853 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Programme : serveur_lapin.c                                           *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Serveur de questions « et si ? » sur la simulation de lapins. Il lit  *
+ *      des commandes sur l'entrée standard, une par ligne, et répond sur la  *
+ *      sortie standard. Chaque question simule une trajectoire dont les      *
+ *      paramètres peuvent changer à partir d'une année donnée.               *
+ *                                                                            *
+ *      Les trajectoires déjà simulées sont gardées en cache avec leurs       *
+ *      points de reprise (état du générateur de chaque année). Une nouvelle  *
+ *      question repart de l'année la plus tardive commune avec une           *
+ *      trajectoire du cache et ne simule que la suite qui diverge. Le cache  *
+ *      respecte un budget mémoire en évinçant les trajectoires les moins     *
+ *      récemment utilisées.                                                  *
+ *                                                                            *
+ *      Il se compile comme suit (voir simu_fin.c pour la bibliothèque) :     *
+ *      gcc -Wall -O2 serveur_lapin.c -L. -lsimu_lapin -lm -o serveur_lapin   *
+ *      Puis :                                                                *
+ *      ./serveur_lapin                                                       *
+ *      Pour l'utiliser sur une socket locale, on peut passer par socat :     *
+ *      socat UNIX-LISTEN:/tmp/lapin.sock,fork EXEC:./serveur_lapin           *
+ *                                                                            *
+ *      Commandes :                                                           *
+ *      graine <n>                    Graine du générateur                    *
+ *      peupler <femelles|males> <age> <nombre>                               *
+ *      param <nom> <valeur>          Paramètre de base (voir simu_lapin.h)   *
+ *      budget <octets>               Budget mémoire du cache                 *
+ *      simuler <nb_annee> [<annee>:<nom>=<valeur> ...]                       *
+ *      stats                         État du cache                           *
+ *      quitter                                                               *
+ *                                                                            *
+ *      Par exemple, « simuler 27 15:survie_adulte=0.5 » simule 27 années     *
+ *      où la survie des adultes tombe à 0.5 à partir de l'année 15.          *
+ *      Une valeur que la bibliothèque refuserait (survie hors de [0, 1],     *
+ *      entier hors des int, ...) est rejetée par « erreur » dès sa lecture,  *
+ *      sans rien changer à la session.                                       *
+ *      La réponse donne l'année de reprise, puis pour chaque année le        *
+ *      nombre de femelles et de mâles vivants, et se termine par « fin ».    *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <limits.h>
+#include <math.h>
+
+#include "simu_lapin.h"
+
+/* -------------------------------------------------------------------------- */
+/*                                Constantes                                  */
+/* -------------------------------------------------------------------------- */
+
+#define MAX_LIGNE 4096
+#define MAX_CHANGEMENTS 64
+#define MAX_ENTREES 1024
+#define MAX_AGE 64
+#define BUDGET_DEFAUT (256UL * 1024 * 1024)
+
+/* -------------------------------------------------------------------------- */
+/*                                  Types                                     */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Un scénario décrit complètement une trajectoire : les paramètres de base   *
+ * (graine comprise), la population de l'année 0 et la liste des changements  *
+ * de paramètres, triée par année. Deux scénarios donnent la même trajectoire *
+ * jusqu'à l'année n tant que leurs paramètres coïncident pour les années     *
+ * 0 à n - 1.                                                                 *
+ *                                                                            *
+ ******************************************************************************/
+
+typedef struct Changement
+{
+    int annee;
+    size_t decalage;  // Position du champ dans ParametresSimu
+    int est_entier;   // 1 pour un champ int, 0 pour un double
+    double valeur;
+} Changement;
+
+typedef struct Scenario
+{
+    ParametresSimu base;
+    unsigned long long femelles[MAX_AGE];
+    unsigned long long males[MAX_AGE];
+    Changement changements[MAX_CHANGEMENTS];
+    int nb_changements;
+} Scenario;
+
+typedef struct Entree
+{
+    Scenario scenario;
+    Simulation *sim;
+    unsigned long long dernier_usage;
+} Entree;
+
+typedef struct Cache
+{
+    Entree entrees[MAX_ENTREES];
+    int nb_entrees;
+    size_t taille;
+    size_t budget;
+    unsigned long long horloge;
+    unsigned long long annees_simulees;
+    unsigned long long annees_reprises;
+} Cache;
+
+typedef struct ChampParametre
+{
+    const char *nom;
+    size_t decalage;
+    int est_entier;
+} ChampParametre;
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+int Simuler(Cache *cache, const Scenario *scenario, int nb_annee);
+
+int AnneesCommunes(const Scenario *a, const Scenario *b, int nb_annee);
+
+void ParametresAnnee(const Scenario *scenario, int annee, ParametresSimu *params);
+
+int LireChangement(const char *texte, Changement *changement);
+
+int ChercherChamp(const char *nom, ChampParametre *champ);
+
+int ValeurValide(const Changement *changement);
+
+int ParametresAcceptes(const ParametresSimu *params);
+
+void AppliquerChangement(ParametresSimu *params, const Changement *changement);
+
+void AjouterEntree(Cache *cache, const Scenario *scenario, Simulation *sim);
+
+int MoinsRecente(const Cache *cache);
+
+void RetirerEntree(Cache *cache, int indice);
+
+void Evincer(Cache *cache);
+
+void AfficheTrajectoire(const Simulation *sim, int annee_reprise);
+
+/* -------------------------------------------------------------------------- */
+/*                         Paramètres modifiables                             */
+/* -------------------------------------------------------------------------- */
+
+static const ChampParametre champs[] = {
+    {"age_maturite", offsetof(ParametresSimu, age_maturite), 1},
+    {"age_senescence", offsetof(ParametresSimu, age_senescence), 1},
+    {"survie_petit", offsetof(ParametresSimu, survie_petit), 0},
+    {"survie_adulte", offsetof(ParametresSimu, survie_adulte), 0},
+    {"decroissance_senescence", offsetof(ParametresSimu, decroissance_senescence), 0},
+    {"proba_femelle", offsetof(ParametresSimu, proba_femelle), 0},
+    {"portee_min", offsetof(ParametresSimu, portee_min), 1},
+    {"nb_classes_portee", offsetof(ParametresSimu, nb_classes_portee), 1},
+    {"lapins_portee_min", offsetof(ParametresSimu, lapins_portee_min), 1},
+    {"lapins_portee_max", offsetof(ParametresSimu, lapins_portee_max), 1},
+};
+
+/* -------------------------------------------------------------------------- */
+/*                         Fonction 'main' principale                         */
+/* -------------------------------------------------------------------------- */
+
+int main(void)
+{
+
+    char ligne[MAX_LIGNE], nom[64], *mot, *reste;
+    int i, age, nb_annee;
+    unsigned long long nombre;
+    double valeur;
+    ChampParametre champ;
+    Changement changement;
+    ParametresSimu essai;
+    Scenario session, requete;
+    static Cache cache;
+
+    //  La session commence avec les paramètres et la population du
+    //  programme simu_fin.c : 10 femelles et 10 mâles de 10 ans.
+    memset(&session, 0, sizeof(Scenario));
+    ParametresSimuDefaut(&session.base);
+    session.femelles[10] = 10;
+    session.males[10] = 10;
+
+    cache.budget = BUDGET_DEFAUT;
+
+    while (fgets(ligne, sizeof(ligne), stdin) != NULL)
+    {
+
+        mot = strtok(ligne, " \t\r\n");
+        reste = strtok(NULL, "\r\n");
+
+        if (mot == NULL)
+        {
+            continue;
+        }
+        else if (strcmp(mot, "quitter") == 0)
+        {
+            break;
+        }
+        else if (strcmp(mot, "graine") == 0 && reste != NULL &&
+                 sscanf(reste, "%llu", &nombre) == 1)
+        {
+            session.base.graine = (unsigned long)nombre;
+            printf("ok\n");
+        }
+        else if (strcmp(mot, "peupler") == 0 && reste != NULL &&
+                 sscanf(reste, "%63s %d %llu", nom, &age, &nombre) == 3 &&
+                 age >= 1 && age < session.base.age_max &&
+                 (strcmp(nom, "femelles") == 0 || strcmp(nom, "males") == 0))
+        {
+            if (strcmp(nom, "femelles") == 0)
+            {
+                session.femelles[age] = nombre;
+            }
+            else
+            {
+                session.males[age] = nombre;
+            }
+            printf("ok\n");
+        }
+        else if (strcmp(mot, "param") == 0 && reste != NULL &&
+                 sscanf(reste, "%63s %lf", nom, &valeur) == 2 &&
+                 ChercherChamp(nom, &champ))
+        {
+            //  Le changement est essayé sur une copie : une valeur refusée ne
+            //  doit pas casser toutes les simulations suivantes de la session.
+            changement.annee = 0;
+            changement.decalage = champ.decalage;
+            changement.est_entier = champ.est_entier;
+            changement.valeur = valeur;
+            essai = session.base;
+            if (ValeurValide(&changement))
+            {
+                AppliquerChangement(&essai, &changement);
+            }
+            if (!ValeurValide(&changement) || !ParametresAcceptes(&essai))
+            {
+                printf("erreur valeur invalide : %s\n", nom);
+            }
+            else
+            {
+                session.base = essai;
+                printf("ok\n");
+            }
+        }
+        else if (strcmp(mot, "budget") == 0 && reste != NULL &&
+                 sscanf(reste, "%llu", &nombre) == 1)
+        {
+            cache.budget = (size_t)nombre;
+            Evincer(&cache);
+            printf("ok\n");
+        }
+        else if (strcmp(mot, "stats") == 0)
+        {
+            printf("entrees %d taille %lu budget %lu annees_simulees %llu annees_reprises %llu\n",
+                   cache.nb_entrees, (unsigned long)cache.taille, (unsigned long)cache.budget,
+                   cache.annees_simulees, cache.annees_reprises);
+        }
+        else if (strcmp(mot, "simuler") == 0 && reste != NULL &&
+                 sscanf(reste, "%d", &nb_annee) == 1 && nb_annee >= 1)
+        {
+            requete = session;
+
+            //  Les changements suivent le nombre d'années, séparés par des
+            //  espaces.
+            strtok(reste, " \t");
+            while ((mot = strtok(NULL, " \t")) != NULL)
+            {
+                if (requete.nb_changements == MAX_CHANGEMENTS || !LireChangement(mot, &changement))
+                {
+                    break;
+                }
+                //  On insère le changement à sa place pour garder la liste
+                //  triée par année.
+                for (i = requete.nb_changements; i > 0 && requete.changements[i - 1].annee > changement.annee; i--)
+                {
+                    requete.changements[i] = requete.changements[i - 1];
+                }
+                requete.changements[i] = changement;
+                requete.nb_changements++;
+
+                //  Les paramètres de l'année du changement doivent rester
+                //  acceptables, compte tenu des changements déjà lus.
+                ParametresAnnee(&requete, changement.annee, &essai);
+                if (!ParametresAcceptes(&essai))
+                {
+                    break;
+                }
+            }
+
+            if (mot != NULL)
+            {
+                printf("erreur changement invalide : %s\n", mot);
+            }
+            else if (Simuler(&cache, &requete, nb_annee) != SIMU_OK)
+            {
+                printf("erreur simulation impossible\n");
+            }
+        }
+        else
+        {
+            printf("erreur commande invalide\n");
+        }
+
+        fflush(stdout);
+    }
+
+    while (cache.nb_entrees > 0)
+    {
+        RetirerEntree(&cache, cache.nb_entrees - 1);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                       Fonctions servant au programme                       */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int Simuler(Cache *cache, const Scenario *scenario,             *
+ *                        int nb_annee)                                       *
+ *                                                                            *
+ * Répond à une question : cherche dans le cache la trajectoire qui a le plus *
+ * d'années en commun avec le scénario, en fait une copie arrêtée à la        *
+ * dernière année commune, puis simule le reste année par année avec les      *
+ * paramètres du scénario. La trajectoire obtenue est affichée puis ajoutée   *
+ * au cache.                                                                  *
+ *                                                                            *
+ * En entrée : Le cache                                                       *
+ *             Le scénario à simuler                                          *
+ *             Le nombre d'années voulu (année 0 comprise)                    *
+ *                                                                            *
+ * En sortie : SIMU_OK ou un code d'erreur de la bibliothèque.                *
+ *                                                                            *
+ ******************************************************************************/
+
+int Simuler(Cache *cache, const Scenario *scenario, int nb_annee)
+{
+
+    int i, age, communes, meilleur = -1, meilleur_communes = 0, annee_reprise;
+    int nb_annee_entree, code;
+    ParametresSimu params;
+    Simulation *sim;
+
+    if (scenario->base.age_max > MAX_AGE)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    for (i = 0; i < cache->nb_entrees; i++)
+    {
+        nb_annee_entree = SimulationNbAnnees(cache->entrees[i].sim);
+        communes = AnneesCommunes(&cache->entrees[i].scenario, scenario,
+                                  nb_annee_entree < nb_annee ? nb_annee_entree : nb_annee);
+
+        if (communes > meilleur_communes)
+        {
+            meilleur = i;
+            meilleur_communes = communes;
+        }
+    }
+
+    if (meilleur >= 0)
+    {
+        sim = SimulationCopier(cache->entrees[meilleur].sim, meilleur_communes);
+        cache->entrees[meilleur].dernier_usage = ++cache->horloge;
+    }
+    else
+    {
+        ParametresAnnee(scenario, 0, &params);
+        sim = SimulationCreer(&params);
+
+        for (age = 1; sim != NULL && age < params.age_max; age++)
+        {
+            SimulationPeupler(sim, SIMU_FEMELLES, age, scenario->femelles[age]);
+            SimulationPeupler(sim, SIMU_MALES, age, scenario->males[age]);
+        }
+    }
+
+    if (sim == NULL)
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    annee_reprise = SimulationNbAnnees(sim) - 1;
+    cache->annees_reprises += annee_reprise;
+
+    //  On ne simule que la suite qui diverge, en appliquant à chaque année
+    //  les paramètres que le scénario lui donne.
+    while (SimulationNbAnnees(sim) < nb_annee)
+    {
+        ParametresAnnee(scenario, SimulationNbAnnees(sim) - 1, &params);
+
+        code = SimulationModifierParametres(sim, &params);
+        if (code == SIMU_OK)
+        {
+            code = SimulationAvancer(sim, 1);
+        }
+
+        if (code != SIMU_OK)
+        {
+            SimulationDetruire(sim);
+            return code;
+        }
+
+        cache->annees_simulees++;
+    }
+
+    AfficheTrajectoire(sim, annee_reprise);
+
+    if (annee_reprise == nb_annee - 1 && meilleur >= 0)
+    {
+        //  Tout était déjà en cache, la copie n'apporte rien de nouveau.
+        SimulationDetruire(sim);
+    }
+    else
+    {
+        AjouterEntree(cache, scenario, sim);
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AnneesCommunes(const Scenario *a, const Scenario *b,        *
+ *                               int nb_annee)                                *
+ *                                                                            *
+ * Calcule combien d'années de la trajectoire du scénario a peuvent servir    *
+ * telles quelles au scénario b. Les survivants de l'année n ne dépendent     *
+ * que de la graine, de la population de départ et des paramètres des années  *
+ * 0 à n - 1.                                                                 *
+ *                                                                            *
+ * En entrée : Les deux scénarios                                             *
+ *             Le nombre d'années disponibles dans la trajectoire de a        *
+ *                                                                            *
+ * En sortie : Le nombre d'années réutilisables, 0 si aucune.                 *
+ *                                                                            *
+ ******************************************************************************/
+
+int AnneesCommunes(const Scenario *a, const Scenario *b, int nb_annee)
+{
+
+    int annee;
+    ParametresSimu params_a, params_b;
+
+    //  Les structures sont toujours remplies par ParametresSimuDefaut, qui les
+    //  met à zéro, on peut donc les comparer octet par octet.
+    if (a->base.graine != b->base.graine || a->base.age_max != b->base.age_max ||
+        memcmp(a->femelles, b->femelles, sizeof(a->femelles)) != 0 ||
+        memcmp(a->males, b->males, sizeof(a->males)) != 0)
+    {
+        return 0;
+    }
+
+    for (annee = 0; annee < nb_annee - 1; annee++)
+    {
+        ParametresAnnee(a, annee, &params_a);
+        ParametresAnnee(b, annee, &params_b);
+
+        if (memcmp(&params_a, &params_b, sizeof(ParametresSimu)) != 0)
+        {
+            return annee + 1;
+        }
+    }
+
+    return nb_annee;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void ParametresAnnee(const Scenario *scenario, int annee,       *
+ *                                 ParametresSimu *params)                    *
+ *                                                                            *
+ * Calcule les paramètres en vigueur pendant une année du scénario : ceux de  *
+ * base, modifiés par tous les changements survenus jusqu'à cette année.      *
+ *                                                                            *
+ * En entrée : Le scénario                                                    *
+ *             L'année voulue                                                 *
+ *             Les paramètres à remplir                                       *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void ParametresAnnee(const Scenario *scenario, int annee, ParametresSimu *params)
+{
+
+    int i;
+
+    *params = scenario->base;
+
+    //  Les changements sont triés par année, le dernier arrivé l'emporte.
+    for (i = 0; i < scenario->nb_changements && scenario->changements[i].annee <= annee; i++)
+    {
+        AppliquerChangement(params, &scenario->changements[i]);
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int LireChangement(const char *texte, Changement *changement)   *
+ *                                                                            *
+ * Lit un changement de la forme <annee>:<nom>=<valeur>, par exemple          *
+ * 15:survie_adulte=0.5 ou 3:repartition_portee[2]=0.8.                       *
+ *                                                                            *
+ * En entrée : Le texte à lire                                                *
+ *             Le changement à remplir                                        *
+ *                                                                            *
+ * En sortie : 1 si le texte est valide et la valeur représentable dans le    *
+ *             champ (voir ValeurValide)                                      *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int LireChangement(const char *texte, Changement *changement)
+{
+
+    char nom[64];
+    ChampParametre champ;
+
+    if (sscanf(texte, "%d:%63[^=]=%lf", &changement->annee, nom, &changement->valeur) != 3 ||
+        changement->annee < 0 || !ChercherChamp(nom, &champ))
+    {
+        return 0;
+    }
+
+    changement->decalage = champ.decalage;
+    changement->est_entier = champ.est_entier;
+
+    return ValeurValide(changement);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int ValeurValide(const Changement *changement)                  *
+ *                                                                            *
+ * Vérifie que la valeur d'un changement peut être écrite dans son champ :    *
+ * finie, et pour un champ int comprise entre INT_MIN et INT_MAX (convertir   *
+ * un double hors de cet intervalle en int n'est pas défini).                 *
+ *                                                                            *
+ * En entrée : Le changement                                                  *
+ *                                                                            *
+ * En sortie : 1 si la valeur est représentable                               *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int ValeurValide(const Changement *changement)
+{
+    if (!isfinite(changement->valeur))
+    {
+        return 0;
+    }
+
+    return !changement->est_entier ||
+           (changement->valeur >= (double)INT_MIN && changement->valeur <= (double)INT_MAX);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int ParametresAcceptes(const ParametresSimu *params)            *
+ *                                                                            *
+ * Soumet des paramètres aux vérifications de la bibliothèque en créant une   *
+ * simulation d'essai, aussitôt détruite.                                     *
+ *                                                                            *
+ * En entrée : Les paramètres                                                 *
+ *                                                                            *
+ * En sortie : 1 si SimulationCreer les accepte                               *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int ParametresAcceptes(const ParametresSimu *params)
+{
+
+    Simulation *sim;
+
+    if (params->age_max > MAX_AGE)
+    {
+        return 0;
+    }
+
+    sim = SimulationCreer(params);
+    if (sim == NULL)
+    {
+        return 0;
+    }
+    SimulationDetruire(sim);
+
+    return 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int ChercherChamp(const char *nom, ChampParametre *champ)       *
+ *                                                                            *
+ * Retrouve un champ de ParametresSimu à partir de son nom. Les classes de    *
+ * portées s'écrivent repartition_portee[i].                                  *
+ *                                                                            *
+ * En entrée : Le nom du champ                                                *
+ *             La description du champ à remplir                              *
+ *                                                                            *
+ * En sortie : 1 si le champ existe et peut être modifié                      *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int ChercherChamp(const char *nom, ChampParametre *champ)
+{
+
+    int i;
+    char fin;
+
+    if (sscanf(nom, "repartition_portee[%d%c", &i, &fin) == 2 && fin == ']' &&
+        i >= 0 && i < SIMU_MAX_PORTEE)
+    {
+        champ->nom = nom;
+        champ->decalage = offsetof(ParametresSimu, repartition_portee) + i * sizeof(double);
+        champ->est_entier = 0;
+        return 1;
+    }
+
+    for (i = 0; i < (int)(sizeof(champs) / sizeof(champs[0])); i++)
+    {
+        if (strcmp(nom, champs[i].nom) == 0)
+        {
+            *champ = champs[i];
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void AppliquerChangement(ParametresSimu *params,                *
+ *                                     const Changement *changement)          *
+ *                                                                            *
+ * Écrit la valeur d'un changement dans le champ correspondant.               *
+ *                                                                            *
+ * En entrée : Les paramètres à modifier                                      *
+ *             Le changement                                                  *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void AppliquerChangement(ParametresSimu *params, const Changement *changement)
+{
+
+    char *champ = (char *)params + changement->decalage;
+
+    if (changement->est_entier)
+    {
+        *(int *)champ = (int)changement->valeur;
+    }
+    else
+    {
+        *(double *)champ = changement->valeur;
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void AjouterEntree(Cache *cache, const Scenario *scenario,      *
+ *                               Simulation *sim)                             *
+ *                                                                            *
+ * Ajoute une trajectoire au cache, qui en devient propriétaire. Les          *
+ * trajectoires du cache qui n'en sont qu'un début sont retirées, puis on     *
+ * évince les moins récemment utilisées pour tenir le budget mémoire.         *
+ *                                                                            *
+ * En entrée : Le cache                                                       *
+ *             Le scénario de la trajectoire                                  *
+ *             La trajectoire                                                 *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void AjouterEntree(Cache *cache, const Scenario *scenario, Simulation *sim)
+{
+
+    int i, nb_annee_entree;
+    Entree *entree;
+
+    for (i = cache->nb_entrees - 1; i >= 0; i--)
+    {
+        nb_annee_entree = SimulationNbAnnees(cache->entrees[i].sim);
+
+        if (nb_annee_entree <= SimulationNbAnnees(sim) &&
+            AnneesCommunes(&cache->entrees[i].scenario, scenario, nb_annee_entree) == nb_annee_entree)
+        {
+            RetirerEntree(cache, i);
+        }
+    }
+
+    if (cache->nb_entrees == MAX_ENTREES)
+    {
+        RetirerEntree(cache, MoinsRecente(cache));
+    }
+
+    entree = &cache->entrees[cache->nb_entrees++];
+    entree->scenario = *scenario;
+    entree->sim = sim;
+    entree->dernier_usage = ++cache->horloge;
+    cache->taille += SimulationTailleMemoire(sim);
+
+    Evincer(cache);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int MoinsRecente(const Cache *cache)                            *
+ *                                                                            *
+ * En sortie : L'indice de l'entrée la moins récemment utilisée du cache,     *
+ *             qui ne doit pas être vide.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int MoinsRecente(const Cache *cache)
+{
+
+    int i, indice = 0;
+
+    for (i = 1; i < cache->nb_entrees; i++)
+    {
+        if (cache->entrees[i].dernier_usage < cache->entrees[indice].dernier_usage)
+        {
+            indice = i;
+        }
+    }
+
+    return indice;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void RetirerEntree(Cache *cache, int indice)                    *
+ *                                                                            *
+ * Libère une entrée du cache et la remplace par la dernière.                 *
+ *                                                                            *
+ * En entrée : Le cache                                                       *
+ *             L'indice de l'entrée à retirer                                 *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void RetirerEntree(Cache *cache, int indice)
+{
+
+    cache->taille -= SimulationTailleMemoire(cache->entrees[indice].sim);
+    SimulationDetruire(cache->entrees[indice].sim);
+
+    cache->entrees[indice] = cache->entrees[--cache->nb_entrees];
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void Evincer(Cache *cache)                                      *
+ *                                                                            *
+ * Retire les entrées les moins récemment utilisées tant que le cache dépasse *
+ * son budget. La plus récente est toujours gardée.                           *
+ *                                                                            *
+ * En entrée : Le cache.                                                      *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void Evincer(Cache *cache)
+{
+    while (cache->nb_entrees > 1 && cache->taille > cache->budget)
+    {
+        RetirerEntree(cache, MoinsRecente(cache));
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void AfficheTrajectoire(const Simulation *sim,                  *
+ *                                    int annee_reprise)                      *
+ *                                                                            *
+ * Affiche la réponse à une question : l'année à partir de laquelle la        *
+ * trajectoire a été recalculée, puis pour chaque année le nombre total de    *
+ * femelles et de mâles vivants.                                              *
+ *                                                                            *
+ * En entrée : La trajectoire                                                 *
+ *             L'année de reprise                                             *
+ *                                                                            *
+ * En sortie : Rien, cette fonction ne fait que de l'affichage.               *
+ *                                                                            *
+ ******************************************************************************/
+
+void AfficheTrajectoire(const Simulation *sim, int annee_reprise)
+{
+
+    int annee, age;
+    unsigned long long nb_femelles, nb_males;
+    const unsigned long long *femelles, *males;
+
+    printf("reprise %d\n", annee_reprise);
+
+    for (annee = 0; annee < SimulationNbAnnees(sim); annee++)
+    {
+        femelles = SimulationCohorte(sim, annee, SIMU_FEMELLES);
+        males = SimulationCohorte(sim, annee, SIMU_MALES);
+        nb_femelles = 0;
+        nb_males = 0;
+
+        for (age = 0; age < SimulationAgeMax(sim); age++)
+        {
+            nb_femelles += femelles[age];
+            nb_males += males[age];
+        }
+
+        printf("%d %llu %llu\n", annee, nb_femelles, nb_males);
+    }
+
+    printf("fin\n");
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Fichier : simu_forme.h                                                *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Forme du modèle pour laquelle la bibliothèque génère des noyaux       *
+ *      spécialisés quand elle est compilée avec -DSIMU_FORME_FIXE :          *
+ *      gcc -Wall -O2 -DSIMU_FORME_FIXE -c simu_lapin.c                       *
+ *                                                                            *
+ *      Chaque valeur peut être redéfinie à la compilation, par exemple       *
+ *      -DSIMU_FORME_AGE_MAX=20. Les noyaux spécialisés utilisent ces         *
+ *      valeurs comme des constantes : les boucles sur les âges sont          *
+ *      entièrement déroulées et les seuils de survie de chaque âge sont      *
+ *      calculés par le compilateur. Ils ne sont utilisés que si les          *
+ *      paramètres de la simulation sont exactement ceux-ci, sinon on passe   *
+ *      par les fonctions génériques. Les résultats sont identiques dans les  *
+ *      deux cas, tirage pour tirage.                                         *
+ *                                                                            *
+ *      Ce fichier n'est pas public, il n'est inclus que par simu_lapin.c.    *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef SIMU_FORME_H
+#define SIMU_FORME_H
+
+#ifndef SIMU_FORME_AGE_MAX
+#define SIMU_FORME_AGE_MAX 16
+#endif
+
+#ifndef SIMU_FORME_AGE_MATURITE
+#define SIMU_FORME_AGE_MATURITE 1
+#endif
+
+#ifndef SIMU_FORME_AGE_SENESCENCE
+#define SIMU_FORME_AGE_SENESCENCE 10
+#endif
+
+#ifndef SIMU_FORME_SURVIE_PETIT
+#define SIMU_FORME_SURVIE_PETIT 0.12
+#endif
+
+#ifndef SIMU_FORME_SURVIE_ADULTE
+#define SIMU_FORME_SURVIE_ADULTE 0.60
+#endif
+
+#ifndef SIMU_FORME_DECROISSANCE
+#define SIMU_FORME_DECROISSANCE 0.1
+#endif
+
+#ifndef SIMU_FORME_PROBA_FEMELLE
+#define SIMU_FORME_PROBA_FEMELLE 0.5
+#endif
+
+#ifndef SIMU_FORME_PORTEE_MIN
+#define SIMU_FORME_PORTEE_MIN 4
+#endif
+
+//  Répartition cumulée du nombre de portées, une valeur par classe.
+#ifndef SIMU_FORME_REPARTITION_PORTEE
+#define SIMU_FORME_REPARTITION_PORTEE {0.1, 0.3, 0.7, 0.9, 1.0}
+#endif
+
+#ifndef SIMU_FORME_LAPINS_PORTEE_MIN
+#define SIMU_FORME_LAPINS_PORTEE_MIN 3
+#endif
+
+#ifndef SIMU_FORME_LAPINS_PORTEE_MAX
+#define SIMU_FORME_LAPINS_PORTEE_MAX 6
+#endif
+
+//  Demande au compilateur de dérouler entièrement la boucle qui suit.
+#if defined(__clang__)
+#define SIMU_DEROULER _Pragma("unroll")
+#elif defined(__GNUC__)
+#define SIMU_DEROULER _Pragma("GCC unroll 64")
+#else
+#define SIMU_DEROULER
+#endif
+
+#endif
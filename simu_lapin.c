@@ -0,0 +1,2471 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Bibliothèque : simu_lapin.c                                           *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Moteur de la simulation de la population de lapins. Ce fichier        *
+ *      contient les fonctions de naissance, de mortalité et d'évolution      *
+ *      qui étaient auparavant dans le programme principal, ainsi que les     *
+ *      fonctions de l'interface publique décrite dans simu_lapin.h.          *
+ *                                                                            *
+ *      Chaque simulation possède son propre générateur MT19937, plusieurs    *
+ *      simulations peuvent donc coexister dans un même processus.            *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "mt19937ar.h"
+#include "simu_lapin.h"
+
+#ifdef SIMU_FORME_FIXE
+#include "simu_forme.h"
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Une simulation stocke toutes les années simulées dans un seul tampon       *
+ * contigu, de la forme [Année][Ligne][Âge], avec la même représentation que  *
+ * celle décrite dans simu_fin.c. La dernière année du tableau ne contient    *
+ * que les survivants de l'année précédente : ses naissances et ses morts ne  *
+ * sont calculées qu'au moment où l'on avance d'une année.                    *
+ *                                                                            *
+ * Pour chaque année déjà avancée, on garde aussi un point de reprise : l'état*
+ * du générateur et les paramètres juste avant le calcul de ses naissances.   *
+ * C'est ce qui permet de repartir d'une année quelconque avec                *
+ * SimulationCopier sans tout resimuler depuis l'année 0.                     *
+ *                                                                            *
+ * Le tampon portees compte, pour chaque année avancée, le nombre de lapines  *
+ * qui ont eu chaque nombre de portées ([Année][Classe]).                     *
+ *                                                                            *
+ * Tous les tirages uniformes passent par Tirage : les nb_premiers premiers   *
+ * sont pris dans premiers (un point d'un plan d'expérience), les suivants    *
+ * viennent du générateur, remplacés par 1 - u si antithetique est fixé.      *
+ *                                                                            *
+ ******************************************************************************/
+
+typedef struct Reprise
+{
+    mt_state generateur;
+    ParametresSimu params;
+    int indice_premier;
+} Reprise;
+
+struct Simulation
+{
+    ParametresSimu params;
+    mt_state generateur;
+    unsigned long long *tableau;
+    unsigned long long *portees;
+    Reprise *reprises;
+    unsigned long long replique;
+    int nb_annee;
+    int capacite;
+    int antithetique;
+    int nb_premiers;
+    int indice_premier;
+    double premiers[SIMU_MAX_PREMIERS];
+};
+
+//  Variance n p (1 - p) à partir de laquelle BinomialeInverse passe à
+//  l'approximation de Cornish-Fisher (voir QuantileCornishFisher).
+#define VARIANCE_NORMALE 1e6
+
+//  Nombre de termes de FractionBeta au-delà duquel on renonce.
+#define MAX_TERMES_FRACTION 100000
+
+//  ln(racine(2 pi)).
+#define LOG_RACINE_2PI 0.91893853320467274178
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+static double Tirage(Simulation *sim);
+
+static double Uniform(Simulation *sim, double borne_inf, double borne_sup);
+
+static int nbLapinPortee(Simulation *sim);
+
+static int nbPortee(Simulation *sim);
+
+static int SexeLapin(Simulation *sim);
+
+static int MortPetit(Simulation *sim);
+
+static int MortAdulte(Simulation *sim, double decroissance);
+
+static void NaissanceSexuee(Simulation *sim, int annee);
+
+static void Mortalite(Simulation *sim, int annee);
+
+static int Evolution(Simulation *sim, int nb_annee);
+
+static int NaissanceAgregee(Simulation *sim, int annee);
+
+static int MortaliteAgregee(Simulation *sim, int annee);
+
+static int Binomiale(Simulation *sim, unsigned long long n, double p, unsigned long long *succes);
+
+static int BinomialeInverse(unsigned long long n, double p, double u, unsigned long long *quantile);
+
+static unsigned long long QuantileCornishFisher(unsigned long long n, double p, double u);
+
+static double QuantileNormal(double u);
+
+static int RepartitionBinomiale(unsigned long long n, unsigned long long k, double p, double *repartition);
+
+static int QueueBinomiale(unsigned long long n, unsigned long long k, double p, int superieure, double *queue);
+
+static double ProbabiliteBinomiale(unsigned long long n, unsigned long long k, double p);
+
+static double DeviationBinomiale(double x, double ecart);
+
+static double EcartStirling(double z);
+
+static int FractionBeta(double a, double b, double x, double *fraction);
+
+static int AjouterProduit(unsigned long long *total, unsigned long long n, unsigned long long facteur);
+
+static int EffectifsRepresentables(const Simulation *sim, int annee);
+
+static void AnnulerAnnee(Simulation *sim, int annee);
+
+#ifdef SIMU_FORME_FIXE
+
+static int FormeFixe(const ParametresSimu *params);
+
+static void NaissanceSexueeFixe(Simulation *sim, int annee);
+
+static void MortaliteFixe(Simulation *sim, int annee);
+
+static void VieillissementFixe(Simulation *sim, int annee);
+
+#endif
+
+static int AllocationTableau(Simulation *sim, int nb_annee);
+
+static size_t TailleAnnee(const Simulation *sim);
+
+static unsigned long long *Ligne(const Simulation *sim, int annee, int ligne);
+
+static int ParametresValides(const ParametresSimu *params);
+
+static int CopierParametres(ParametresSimu *destination, const ParametresSimu *source);
+
+static void FluxCommun(Simulation *sim, int annee, int tirage);
+
+/* -------------------------------------------------------------------------- */
+/*                         Fonctions de l'interface                           */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimuVersionAbi()                                            *
+ *                                                                            *
+ * Permet à un programme lié dynamiquement de vérifier que la bibliothèque    *
+ * chargée correspond à l'en-tête avec lequel il a été compilé.               *
+ *                                                                            *
+ * En entrée : Rien.                                                          *
+ *                                                                            *
+ * En sortie : La version de l'ABI de la bibliothèque.                        *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimuVersionAbi(void)
+{
+    return SIMU_VERSION_ABI;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int ParametresSimuDefautTaille(ParametresSimu *params,          *
+ *                                           size_t taille)                   *
+ *                                                                            *
+ * Remplit les paramètres avec les valeurs du programme d'origine, sans       *
+ * écrire au-delà des taille premiers octets : un appelant compilé avec un    *
+ * simu_lapin.h plus ancien a une structure plus courte que celle de la       *
+ * bibliothèque. Le champ taille reçoit le nombre d'octets remplis, ce qui    *
+ * permet ensuite à CopierParametres de ne lire que ceux-là. Les octets       *
+ * remplis qui ne sont pas des champs (alignement, réserves) sont mis à zéro. *
+ *                                                                            *
+ * C'est la fonction qu'appelle la macro ParametresSimuDefaut de l'en-tête,   *
+ * avec sizeof de la structure de l'appelant.                                 *
+ *                                                                            *
+ * En entrée : Les paramètres à initialiser                                   *
+ *             La taille de la structure de l'appelant                        *
+ *                                                                            *
+ * En sortie : SIMU_OK                                                        *
+ *             SIMU_ERREUR_PARAMETRE si la structure est plus courte que      *
+ *             celle de la première version de l'ABI.                         *
+ *                                                                            *
+ * La répartition du nombre de portées est la suivante (cumulée) :            *
+ *                                                                            *
+ *                          ██████  4 - 10 %                                  *
+ *                          ██████████  5 - 20 %                              *
+ *                          ██████████████  6 - 40 %                          *
+ *                          ██████████  7 - 20 %                              *
+ *                          ██████  8 - 10 %                                  *
+ *                                                                            *
+ ******************************************************************************/
+
+int ParametresSimuDefautTaille(ParametresSimu *params, size_t taille)
+{
+
+    double repartition[5] = {0.1, 0.3, 0.7, 0.9, 1.0};
+    int i;
+    ParametresSimu defaut;
+
+    if (params == NULL || taille < SIMU_TAILLE_PARAMETRES_V1)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+    if (taille > sizeof(ParametresSimu))
+    {
+        taille = sizeof(ParametresSimu);
+    }
+
+    memset(&defaut, 0, sizeof(ParametresSimu));
+
+    defaut.taille = (unsigned int)taille;
+    defaut.age_max = 16;
+    defaut.age_maturite = 1;
+    defaut.age_senescence = 10;
+    defaut.survie_petit = 0.12;
+    defaut.survie_adulte = 0.60;
+    defaut.decroissance_senescence = 0.1;
+    defaut.proba_femelle = 0.5;
+    defaut.portee_min = 4;
+    defaut.nb_classes_portee = 5;
+    defaut.lapins_portee_min = 3;
+    defaut.lapins_portee_max = 6;
+    defaut.graine = 5489UL;
+
+    for (i = 0; i < 5; i++)
+    {
+        defaut.repartition_portee[i] = repartition[i];
+    }
+
+    memcpy(params, &defaut, taille);
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void ParametresSimuDefaut(ParametresSimu *params)               *
+ *                                                                            *
+ * Point d'entrée de la première version de l'ABI, gardé pour les programmes  *
+ * déjà compilés : il ne connaît pas la taille de leur structure et n'en      *
+ * remplit donc que la partie de la version 1. Les programmes recompilés      *
+ * passent par la macro de même nom, qui appelle ParametresSimuDefautTaille.  *
+ *                                                                            *
+ * En entrée : Les paramètres à initialiser.                                  *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+//  Les parenthèses empêchent le remplacement par la macro de simu_lapin.h.
+void (ParametresSimuDefaut)(ParametresSimu *params)
+{
+    ParametresSimuDefautTaille(params, SIMU_TAILLE_PARAMETRES_V1);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : Simulation *SimulationCreer(const ParametresSimu *params)       *
+ *                                                                            *
+ * Crée une simulation vide (aucun lapin) dont l'année 0 est prête à être     *
+ * peuplée avec SimulationPeupler.                                            *
+ *                                                                            *
+ * En entrée : Les paramètres du modèle.                                      *
+ *                                                                            *
+ * En sortie : La simulation créée                                            *
+ *             NULL si les paramètres sont invalides ou si la mémoire manque. *
+ *                                                                            *
+ ******************************************************************************/
+
+Simulation *SimulationCreer(const ParametresSimu *params)
+{
+
+    Simulation *sim = (Simulation *)calloc(1, sizeof(Simulation));
+
+    if (sim == NULL)
+    {
+        return NULL;
+    }
+
+    if (params == NULL || !CopierParametres(&sim->params, params))
+    {
+        free(sim);
+        return NULL;
+    }
+
+    init_genrand_r(&sim->generateur, params->graine);
+
+    if (AllocationTableau(sim, 1) != SIMU_OK)
+    {
+        SimulationDetruire(sim);
+        return NULL;
+    }
+    sim->nb_annee = 1;
+
+    return sim;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : Simulation *SimulationCreerReplique(                            *
+ *                  const ParametresSimu *params, unsigned long long replique)*
+ *                                                                            *
+ * Comme SimulationCreer, mais le générateur est initialisé avec              *
+ * init_by_array à partir de la graine et du numéro de réplique. Chaque       *
+ * réplique d'un ensemble a ainsi son propre flux aléatoire, qui ne dépend    *
+ * que de ces deux valeurs : on obtient les mêmes résultats quelle que soit   *
+ * la façon dont les répliques sont réparties entre processus et threads.     *
+ *                                                                            *
+ * En entrée : Les paramètres du modèle                                       *
+ *             Le numéro de la réplique                                       *
+ *                                                                            *
+ * En sortie : La simulation créée                                            *
+ *             NULL si les paramètres sont invalides ou si la mémoire manque. *
+ *                                                                            *
+ ******************************************************************************/
+
+Simulation *SimulationCreerReplique(const ParametresSimu *params, unsigned long long replique)
+{
+
+    unsigned long cle[4];
+    Simulation *sim = SimulationCreer(params);
+
+    if (sim != NULL)
+    {
+        cle[0] = params->graine & 0xffffffffUL;
+        cle[1] = ((unsigned long long)params->graine >> 32) & 0xffffffffUL;
+        cle[2] = replique & 0xffffffffUL;
+        cle[3] = (replique >> 32) & 0xffffffffUL;
+        init_by_array_r(&sim->generateur, cle, 4);
+        sim->replique = replique;
+    }
+
+    return sim;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void SimulationDetruire(Simulation *sim)                        *
+ *                                                                            *
+ * Libère la simulation et ses tampons. Les pointeurs obtenus avec            *
+ * SimulationCohorte ou SimulationDonnees ne sont plus valides ensuite.       *
+ *                                                                            *
+ * En entrée : La simulation (NULL est accepté).                              *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+void SimulationDetruire(Simulation *sim)
+{
+    if (sim != NULL)
+    {
+        free(sim->tableau);
+        free(sim->portees);
+        free(sim->reprises);
+        free(sim);
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationPeupler(Simulation *sim, int ligne, int age,      *
+ *                                  unsigned long long nombre)                *
+ *                                                                            *
+ * Fixe le nombre de lapins vivants d'un sexe et d'un âge donnés pour la      *
+ * dernière année de la simulation (l'année 0 juste après la création).       *
+ * L'âge 0 est réservé aux naissances de l'année, il ne peut pas être fixé.   *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             La ligne : SIMU_FEMELLES ou SIMU_MALES                         *
+ *             L'âge des lapins                                               *
+ *             Le nombre de lapins                                            *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_PARAMETRE.                              *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationPeupler(Simulation *sim, int ligne, int age, unsigned long long nombre)
+{
+    if (sim == NULL || (ligne != SIMU_FEMELLES && ligne != SIMU_MALES) ||
+        age < 1 || age >= sim->params.age_max)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    Ligne(sim, sim->nb_annee - 1, ligne)[age] = nombre;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationAvancer(Simulation *sim, int nb_annee)            *
+ *                                                                            *
+ * Fait avancer la simulation de nb_annee années. Le tampon interne peut être *
+ * réalloué : les pointeurs obtenus auparavant ne sont plus valides. Le       *
+ * nombre total d'années ne peut pas dépasser INT_MAX.                        *
+ *                                                                            *
+ * Si la population devient trop grande pour être comptée sur 64 bits, ce    *
+ * qui n'arrive en pratique qu'avec tirages_agreges, la simulation s'arrête à *
+ * la dernière année complète, qui reste lisible et cohérente.                *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             Le nombre d'années à simuler en plus                           *
+ *                                                                            *
+ * En sortie : SIMU_OK, SIMU_ERREUR_PARAMETRE, SIMU_ERREUR_MEMOIRE,           *
+ *             SIMU_ERREUR_DEPASSEMENT ou SIMU_ERREUR_CONVERGENCE (un tirage  *
+ *             agrégé n'a pu être calculé, l'année en cours est alors         *
+ *             annulée de la même façon).                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationAvancer(Simulation *sim, int nb_annee)
+{
+    //  Le nombre total d'années doit rester représentable dans un int.
+    if (sim == NULL || nb_annee < 0 || nb_annee > INT_MAX - sim->nb_annee)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    return Evolution(sim, nb_annee);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationNbAnnees(const Simulation *sim)                   *
+ *                                                                            *
+ * En sortie : Le nombre d'années stockées (année 0 comprise).                *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationNbAnnees(const Simulation *sim)
+{
+    return sim->nb_annee;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationAgeMax(const Simulation *sim)                     *
+ *                                                                            *
+ * En sortie : Le nombre de classes d'âge, c'est-à-dire la longueur d'une     *
+ *             ligne du tableau.                                              *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationAgeMax(const Simulation *sim)
+{
+    return sim->params.age_max;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : const unsigned long long *SimulationCohorte(                    *
+ *                          const Simulation *sim, int annee, int ligne)      *
+ *                                                                            *
+ * Donne accès, sans copie, à une ligne du tableau de résultats.              *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             L'année voulue                                                 *
+ *             La ligne voulue (SIMU_FEMELLES, ..., SIMU_MALES_MORTS)         *
+ *                                                                            *
+ * En sortie : Un pointeur sur SimulationAgeMax(sim) valeurs, valable         *
+ *             jusqu'au prochain appel à SimulationAvancer                    *
+ *             NULL si l'année ou la ligne n'existe pas.                      *
+ *                                                                            *
+ ******************************************************************************/
+
+const unsigned long long *SimulationCohorte(const Simulation *sim, int annee, int ligne)
+{
+    if (sim == NULL || annee < 0 || annee >= sim->nb_annee || ligne < 0 || ligne >= SIMU_NB_LIGNES)
+    {
+        return NULL;
+    }
+
+    return Ligne(sim, annee, ligne);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : const unsigned long long *SimulationDonnees(                    *
+ *                          const Simulation *sim)                            *
+ *                                                                            *
+ * Donne accès, sans copie, à tout le tableau de résultats. La case           *
+ * [annee][ligne][age] se trouve à l'indice                                   *
+ * (annee * SIMU_NB_LIGNES + ligne) * SimulationAgeMax(sim) + age.            *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *                                                                            *
+ * En sortie : Le pointeur sur le tableau, valable jusqu'au prochain appel à  *
+ *             SimulationAvancer.                                             *
+ *                                                                            *
+ ******************************************************************************/
+
+const unsigned long long *SimulationDonnees(const Simulation *sim)
+{
+    return sim->tableau;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : Simulation *SimulationCopier(const Simulation *sim,             *
+ *                                         int nb_annee)                      *
+ *                                                                            *
+ * Crée une nouvelle simulation qui reprend les nb_annee premières années de  *
+ * sim, avec l'état du générateur et les paramètres qu'avait sim au début de  *
+ * la dernière année gardée. Avancer la copie avec les mêmes paramètres       *
+ * redonne donc exactement la suite de sim, et la modifier avec               *
+ * SimulationModifierParametres donne une variante qui ne diverge qu'à partir *
+ * de cette année.                                                            *
+ *                                                                            *
+ * En entrée : La simulation à copier                                         *
+ *             Le nombre d'années à garder (entre 1 et SimulationNbAnnees)    *
+ *                                                                            *
+ * En sortie : La copie                                                       *
+ *             NULL si nb_annee est invalide ou si la mémoire manque.         *
+ *                                                                            *
+ ******************************************************************************/
+
+Simulation *SimulationCopier(const Simulation *sim, int nb_annee)
+{
+
+    Simulation *copie;
+    size_t taille_annee;
+
+    if (sim == NULL || nb_annee < 1 || nb_annee > sim->nb_annee)
+    {
+        return NULL;
+    }
+
+    copie = (Simulation *)calloc(1, sizeof(Simulation));
+    if (copie == NULL)
+    {
+        return NULL;
+    }
+
+    copie->params = sim->params;
+    copie->replique = sim->replique;
+    copie->antithetique = sim->antithetique;
+    copie->nb_premiers = sim->nb_premiers;
+    copie->indice_premier = sim->indice_premier;
+    memcpy(copie->premiers, sim->premiers, sizeof(sim->premiers));
+    if (AllocationTableau(copie, nb_annee) != SIMU_OK)
+    {
+        SimulationDetruire(copie);
+        return NULL;
+    }
+
+    taille_annee = TailleAnnee(sim);
+    memcpy(copie->tableau, sim->tableau, nb_annee * taille_annee * sizeof(unsigned long long));
+    memcpy(copie->portees, sim->portees, (nb_annee - 1) * SIMU_MAX_PORTEE * sizeof(unsigned long long));
+    memcpy(copie->reprises, sim->reprises, (nb_annee - 1) * sizeof(Reprise));
+    copie->nb_annee = nb_annee;
+
+    if (nb_annee == sim->nb_annee)
+    {
+        copie->generateur = sim->generateur;
+    }
+    else
+    {
+        //  La dernière année gardée redevient une année non avancée : on
+        //  efface ses naissances et ses morts, qui seront recalculées.
+        copie->generateur = sim->reprises[nb_annee - 1].generateur;
+        copie->params = sim->reprises[nb_annee - 1].params;
+        copie->indice_premier = sim->reprises[nb_annee - 1].indice_premier;
+
+        Ligne(copie, nb_annee - 1, SIMU_FEMELLES)[0] = 0;
+        Ligne(copie, nb_annee - 1, SIMU_MALES)[0] = 0;
+        memset(Ligne(copie, nb_annee - 1, SIMU_FEMELLES_MORTES), 0, sim->params.age_max * sizeof(unsigned long long));
+        memset(Ligne(copie, nb_annee - 1, SIMU_MALES_MORTS), 0, sim->params.age_max * sizeof(unsigned long long));
+    }
+
+    return copie;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationModifierParametres(Simulation *sim,               *
+ *                                      const ParametresSimu *params)         *
+ *                                                                            *
+ * Change les paramètres utilisés pour les prochaines années. Les années déjà *
+ * avancées ne sont pas modifiées. Le nombre de classes d'âge ne peut pas     *
+ * changer et la graine est ignorée : le générateur continue sa suite.        *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             Les nouveaux paramètres                                        *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_PARAMETRE.                              *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationModifierParametres(Simulation *sim, const ParametresSimu *params)
+{
+
+    ParametresSimu nouveaux;
+
+    if (sim == NULL || params == NULL || !CopierParametres(&nouveaux, params) ||
+        nouveaux.age_max != sim->params.age_max)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    nouveaux.graine = sim->params.graine;
+    sim->params = nouveaux;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : size_t SimulationTailleMemoire(const Simulation *sim)           *
+ *                                                                            *
+ * En sortie : Le nombre d'octets occupés par la simulation et ses tampons,   *
+ *             utile pour tenir un budget mémoire sur un ensemble de          *
+ *             simulations.                                                   *
+ *                                                                            *
+ ******************************************************************************/
+
+size_t SimulationTailleMemoire(const Simulation *sim)
+{
+    return sizeof(Simulation) +
+           (size_t)sim->capacite * ((TailleAnnee(sim) + SIMU_MAX_PORTEE) * sizeof(unsigned long long) + sizeof(Reprise));
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : const unsigned long long *SimulationPortees(                    *
+ *                          const Simulation *sim, int annee)                 *
+ *                                                                            *
+ * Donne accès, sans copie, au nombre de lapines qui ont eu chaque nombre de  *
+ * portées pendant une année : la case i correspond à (portee_min + i)        *
+ * portées. Sert par exemple à calculer le rapport de vraisemblance d'une     *
+ * trajectoire.                                                               *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             L'année voulue, qui doit déjà avoir été avancée                *
+ *                                                                            *
+ * En sortie : Un pointeur sur SIMU_MAX_PORTEE valeurs, valable jusqu'au      *
+ *             prochain appel à SimulationAvancer                             *
+ *             NULL si les naissances de l'année ne sont pas calculées.       *
+ *                                                                            *
+ ******************************************************************************/
+
+const unsigned long long *SimulationPortees(const Simulation *sim, int annee)
+{
+    if (sim == NULL || annee < 0 || annee >= sim->nb_annee - 1)
+    {
+        return NULL;
+    }
+
+    return sim->portees + (size_t)annee * SIMU_MAX_PORTEE;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationFixerTirages(Simulation *sim, int antithetique,   *
+ *                          const double *premiers, int nb_premiers)          *
+ *                                                                            *
+ * Change la source des prochains tirages uniformes de la simulation : les    *
+ * nb_premiers prochains valent premiers[0], premiers[1], ..., puis le        *
+ * générateur reprend la main. Avec antithetique, chaque valeur u du          *
+ * générateur est remplacée par 1 - u, si bien que deux répliques de même     *
+ * flux, l'une antithétique et l'autre non, ont des tirages opposés.          *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             1 pour des tirages antithétiques, 0 sinon                      *
+ *             Les tirages imposés, entre 0 et 1 (NULL si nb_premiers vaut 0) *
+ *             Le nombre de tirages imposés (au plus SIMU_MAX_PREMIERS)       *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_PARAMETRE.                              *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationFixerTirages(Simulation *sim, int antithetique, const double *premiers, int nb_premiers)
+{
+
+    int i;
+
+    if (sim == NULL || nb_premiers < 0 || nb_premiers > SIMU_MAX_PREMIERS ||
+        (nb_premiers > 0 && premiers == NULL))
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    for (i = 0; i < nb_premiers; i++)
+    {
+        if (!(premiers[i] >= 0 && premiers[i] <= 1))
+        {
+            return SIMU_ERREUR_PARAMETRE;
+        }
+    }
+
+    if (nb_premiers > 0)
+    {
+        memcpy(sim->premiers, premiers, nb_premiers * sizeof(double));
+    }
+    sim->nb_premiers = nb_premiers;
+    sim->indice_premier = 0;
+    sim->antithetique = antithetique != 0;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SimulationTiragesParAnnee(const Simulation *sim)            *
+ *                                                                            *
+ * En sortie : Le nombre de tirages uniformes consommés par chaque année      *
+ *             avancée avec tirages_agreges : (nb_classes_portee - 1) pour    *
+ *             les portées, puis (lapins_portee_max - lapins_portee_min)      *
+ *             pour la taille des portées, 1 pour le sexe et age_max par sexe *
+ *             pour la mortalité, dans cet ordre                              *
+ *             -1 sans tirages_agreges, où ce nombre dépend de la population. *
+ *                                                                            *
+ ******************************************************************************/
+
+int SimulationTiragesParAnnee(const Simulation *sim)
+{
+    if (sim == NULL || !sim->params.tirages_agreges)
+    {
+        return -1;
+    }
+
+    return (sim->params.nb_classes_portee - 1) +
+           (sim->params.lapins_portee_max - sim->params.lapins_portee_min) + 1 +
+           2 * sim->params.age_max;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                       Fonctions internes du moteur                         */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int Evolution (Simulation *sim, int nb_annee)                   *
+ *                                                                            *
+ * Permet de calculer nb_annee années supplémentaires sur une population de   *
+ * lapins initialisée avant son appel.                                        *
+ *                                                                            *
+ * En entrée : La simulation, dont la dernière année est initialisée.         *
+ *             Le nombre d'années sur lequel l'algorithme doit simuler la     *
+ *             population de lapins.                                          *
+ *                                                                            *
+ * En sortie : SIMU_OK, SIMU_ERREUR_MEMOIRE, SIMU_ERREUR_DEPASSEMENT ou       *
+ *             SIMU_ERREUR_CONVERGENCE.                                       *
+ *                                                                            *
+ * Les naissances sont écrites directement à l'âge 0 des lignes femelles et   *
+ * mâles de l'année, et les morts dans les lignes de morts. Si la population  *
+ * d'une année, naissances comprises, ne tient plus sur 64 bits, ou si un     *
+ * tirage agrégé échoue, cette année est annulée et la simulation s'arrête à  *
+ * la dernière année complète.                                                *
+ *                                                                            *
+ ******************************************************************************/
+
+static int Evolution(Simulation *sim, int nb_annee)
+{
+
+    int i, n, annee, code;
+    int age_max = sim->params.age_max;
+    unsigned long long *femelles, *femelles_mortes, *males, *males_morts;
+
+    if (AllocationTableau(sim, sim->nb_annee + nb_annee) != SIMU_OK)
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    for (n = 0; n < nb_annee; n++)
+    {
+        annee = sim->nb_annee;
+
+        //  On garde de quoi reprendre la simulation au début de cette année.
+        sim->reprises[annee - 1].generateur = sim->generateur;
+        sim->reprises[annee - 1].params = sim->params;
+        sim->reprises[annee - 1].indice_premier = sim->indice_premier;
+
+#ifdef SIMU_FORME_FIXE
+        //  Si les paramètres correspondent à la forme compilée, on passe par
+        //  les noyaux spécialisés (voir simu_forme.h). Ceux-ci tirent
+        //  directement dans le générateur : il ne faut pas de tirages imposés.
+        if (FormeFixe(&sim->params) && !sim->antithetique && sim->indice_premier >= sim->nb_premiers)
+        {
+            NaissanceSexueeFixe(sim, annee - 1);
+            if (!EffectifsRepresentables(sim, annee - 1))
+            {
+                AnnulerAnnee(sim, annee - 1);
+                return SIMU_ERREUR_DEPASSEMENT;
+            }
+            MortaliteFixe(sim, annee - 1);
+            VieillissementFixe(sim, annee);
+
+            sim->nb_annee++;
+            continue;
+        }
+#endif
+
+        if (sim->params.tirages_agreges)
+        {
+            //  Mêmes lois, mais tirées par cohorte (voir NaissanceAgregee).
+            //  Les effectifs ne sont plus bornés par le temps de calcul et
+            //  peuvent dépasser 64 bits en quelques dizaines d'années.
+            code = NaissanceAgregee(sim, annee - 1);
+            if (code == SIMU_OK && !EffectifsRepresentables(sim, annee - 1))
+            {
+                code = SIMU_ERREUR_DEPASSEMENT;
+            }
+            if (code == SIMU_OK)
+            {
+                code = MortaliteAgregee(sim, annee - 1);
+            }
+            if (code != SIMU_OK)
+            {
+                AnnulerAnnee(sim, annee - 1);
+                return code;
+            }
+        }
+        else
+        {
+            //  On rempli ici les naissances avec le nombre de bébé lapins
+            //  mâles et femelles obtenue durant l'année précédente.
+            NaissanceSexuee(sim, annee - 1);
+            if (!EffectifsRepresentables(sim, annee - 1))
+            {
+                AnnulerAnnee(sim, annee - 1);
+                return SIMU_ERREUR_DEPASSEMENT;
+            }
+
+            //  On rempli ici les morts avec le nombre de lapins mort en
+            //  fonction de leur âge que l'on obtient à la fin de l'année
+            //  précédente en prenant en considération le nombre de naissances.
+            Mortalite(sim, annee - 1);
+        }
+
+        //  On calcul le nombre de lapins de l'année n - 1 à l'année n :
+        //  On remplie le tableau de l'année en cours avec le nombre de lapins qui on
+        //  survécue à l'année précedente en les viellisant d'un an.
+        femelles = Ligne(sim, annee - 1, SIMU_FEMELLES);
+        femelles_mortes = Ligne(sim, annee - 1, SIMU_FEMELLES_MORTES);
+        males = Ligne(sim, annee - 1, SIMU_MALES);
+        males_morts = Ligne(sim, annee - 1, SIMU_MALES_MORTS);
+
+        for (i = 1; i < age_max; i++)
+        {
+            Ligne(sim, annee, SIMU_FEMELLES)[i] = femelles[i - 1] - femelles_mortes[i - 1];
+            Ligne(sim, annee, SIMU_MALES)[i] = males[i - 1] - males_morts[i - 1];
+        }
+
+        sim->nb_annee++;
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void Mortalite (Simulation *sim, int annee)                     *
+ *                                                                            *
+ * Permet de calculer la mortalité des lapins en fonctions de leur âge et de  *
+ * leur sexe.                                                                 *
+ *                                                                            *
+ * En entrée : La simulation, dont les naissances de l'année sont déjà        *
+ *             calculées.                                                     *
+ *             L'année sur laquelle ont veut calculer la mortalité.           *
+ *                                                                            *
+ * En sortie : Rien, les lignes de morts de l'année sont remplies.            *
+ *                                                                            *
+ ******************************************************************************/
+
+static void Mortalite(Simulation *sim, int annee)
+{
+
+    int i, j;
+    unsigned long long k, *vivants, *morts;
+    double decroissance = 0;
+    int lignes_vivants[2] = {SIMU_FEMELLES, SIMU_MALES};
+    int lignes_morts[2] = {SIMU_FEMELLES_MORTES, SIMU_MALES_MORTS};
+
+    for (i = 0; i < 2; i++)
+    {
+        memset(Ligne(sim, annee, lignes_morts[i]), 0, sim->params.age_max * sizeof(unsigned long long));
+    }
+
+    //  Remplissage du tableau mort avec le nombre de bébé lapins morts
+    //  mâles et femelles générés.
+    for (i = 0; i < 2; i++)
+    {
+        vivants = Ligne(sim, annee, lignes_vivants[i]);
+        morts = Ligne(sim, annee, lignes_morts[i]);
+
+        if (vivants[0] > 0)
+        {
+            FluxCommun(sim, annee, 1 + i * sim->params.age_max);
+        }
+        for (k = 0; k < vivants[0]; k++)
+        {
+            morts[0] += MortPetit(sim);
+        }
+    }
+
+    //  Remplissage du tableau mort avec le nombre de lapins adultes morts
+    //  mâles et femelles générés, sauf qu'à partir de l'âge de sénescence,
+    //  leurs chances de survie diminue chaque année.
+
+    for (i = 0; i < 2; i++)
+    {
+        vivants = Ligne(sim, annee, lignes_vivants[i]);
+        morts = Ligne(sim, annee, lignes_morts[i]);
+
+        decroissance = 0;
+        for (j = 1; j < sim->params.age_max; j++)
+        {
+
+            if (j >= sim->params.age_senescence)
+            {
+                decroissance += sim->params.decroissance_senescence;
+            }
+
+            if (vivants[j] > 0)
+            {
+                FluxCommun(sim, annee, 1 + i * sim->params.age_max + j);
+            }
+            for (k = 0; k < vivants[j]; k++)
+            {
+                morts[j] += MortAdulte(sim, decroissance);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int MortPetit(Simulation *sim)                                  *
+ *                                                                            *
+ * Sert à calculer la mortalité des bébés. Ils ont 12 % de chance de survie.  *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *                                                                            *
+ * En sortie : 1 si le bébé lapin est mort                                    *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static int MortPetit(Simulation *sim)
+{
+
+    double val_aleatoire = Tirage(sim);
+    int val_retour = 0;
+    if (val_aleatoire >= sim->params.survie_petit)
+    {
+        val_retour++;
+    }
+
+    return val_retour;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int MortAdulte (Simulation *sim, double decroissance)           *
+ *                                                                            *
+ * Sert à calculer la mortalité des lapins selon leurs âge.                   *
+ * Ils ont 60 % de chance de survie de 1 à 10 ans, mais à partir de 10 ans,   *
+ * leurs chances de survie diminue de 10 % tous les ans.                      *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *             La décroissance, elle est modifié dans la fonction Mortalite   *
+ *             lorsque que le lapin a atteint l'âge de sénescence.            *
+ *                                                                            *
+ * En sortie : 1 si le  lapin est mort                                        *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static int MortAdulte(Simulation *sim, double decroissance)
+{
+
+    double val_aleatoire = Tirage(sim);
+    int val_retour = 0;
+
+    if (val_aleatoire >= (sim->params.survie_adulte - decroissance))
+    {
+        val_retour++;
+    }
+
+    return val_retour;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void NaissanceSexuee (Simulation *sim, int annee)               *
+ *                                                                            *
+ * Permet de calculer le nombre de bébés lapins mâles et femelles en fonction *
+ * du nombre de portées et du nombre de lapins par portées.                   *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *             L'année sur laquelle ont veut calculer le nombre de naissances *
+ *             ainsi que le sexe des nouveaux lapins.                         *
+ *                                                                            *
+ * En sortie : Rien, les bébés sont rangés à l'âge 0 de l'année.              *
+ *                                                                            *
+ * Il y a 50 % de chances d'obtenir un mâle ou une femelle.                   *
+ * Il y a 4 à 8 portées chaques année par lapines adulte, mais il est plus    *
+ * probable d'en avoir 5 à 7.                                                 *
+ * Il y a une équiprobabilité d'obtenir entre 3 et 6 lapins par portée.       *
+ *                                                                            *
+ ******************************************************************************/
+
+static void NaissanceSexuee(Simulation *sim, int annee)
+{
+
+    int j, k, nb_portee, nb_bb_portee;
+    unsigned long long i,
+                       nb_femelles_mature = 0,
+                       nb_bb_males = 0,
+                       nb_bb_femelles = 0;
+    unsigned long long *femelles = Ligne(sim, annee, SIMU_FEMELLES);
+    unsigned long long *portees = sim->portees + (size_t)annee * SIMU_MAX_PORTEE;
+
+    memset(portees, 0, SIMU_MAX_PORTEE * sizeof(unsigned long long));
+
+    for (k = sim->params.age_maturite; k < sim->params.age_max; k++)
+    {
+        nb_femelles_mature += femelles[k];
+    }
+
+    //  On défini ici le nombres de mâles et de femelles créé pour chaque
+    //  femelles mature et pour chaque portées qu'elles donneront.
+
+    FluxCommun(sim, annee, 0);
+    for (i = 0; i < nb_femelles_mature; i++)
+    {
+
+        nb_portee = nbPortee(sim);
+        portees[nb_portee - sim->params.portee_min]++;
+
+        for (j = 0; j < nb_portee; j++)
+        {
+
+            nb_bb_portee = nbLapinPortee(sim);
+
+            for (k = 0; k < nb_bb_portee; k++)
+            {
+
+                if (SexeLapin(sim) == 1)
+                {
+                    nb_bb_males++;
+                }
+                else
+                {
+                    nb_bb_femelles++;
+                }
+            }
+        }
+    }
+
+    //  On rempli le tableau
+    femelles[0] = nb_bb_femelles;
+    Ligne(sim, annee, SIMU_MALES)[0] = nb_bb_males;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int nbPortee(Simulation *sim)                                   *
+ *                                                                            *
+ * Sert à calculer le nombre de portées total par lapine sur une année, en    *
+ * suivant la répartition cumulée des paramètres (par défaut, 4 à 8 portées   *
+ * par an avec plus de chance d'en obtenir entre 5 et 7).                     *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *                                                                            *
+ * En sortie : Le nombre de portée.                                           *
+ *                                                                            *
+ ******************************************************************************/
+
+static int nbPortee(Simulation *sim)
+{
+
+    int i;
+    double valGene = Tirage(sim);
+    const double *pourcentage = sim->params.repartition_portee;
+
+    for (i = 0; i < sim->params.nb_classes_portee - 1; i++)
+    {
+
+        if (valGene <= pourcentage[i])
+        {
+
+            return (sim->params.portee_min + i);
+        }
+    }
+
+    return sim->params.portee_min + sim->params.nb_classes_portee - 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int SexeLapin(Simulation *sim)                                  *
+ *                                                                            *
+ * Permet de déterminer si un lapin est un mâle ou une femelle, il y a 50 %   *
+ * de chance que se soit l'un ou l'autre.                                     *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *                                                                            *
+ * En sortie : 1 si le bébé lapin est mâle                                    *
+ *             0 si c'est une femelle                                         *
+ *                                                                            *
+ ******************************************************************************/
+
+static int SexeLapin(Simulation *sim)
+{
+
+    double val = Tirage(sim);
+    if (val <= sim->params.proba_femelle)
+    {
+        return 0;
+    }
+    else
+    {
+        return 1;
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int nbLapinPortee(Simulation *sim)                              *
+ *                                                                            *
+ * Permet de calculer le nombre de lapin par portées. Il y a équiprobabilité  *
+ * entre lapins_portee_min et lapins_portee_max (3 et 6 par défaut).          *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *                                                                            *
+ * En sortie : Le nombre de lapins par portées                                *
+ *                                                                            *
+ ******************************************************************************/
+
+static int nbLapinPortee(Simulation *sim)
+{
+
+    int x = (int)(Uniform(sim, sim->params.lapins_portee_min - 1.0, sim->params.lapins_portee_max) + 1);
+
+    return x;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double Uniform (Simulation *sim, double borne_inf,              *
+ *                            double borne_sup)                               *
+ *                                                                            *
+ * Permet de générer aléatoirement un nombre de type double compris entre     *
+ * borne_inf et borne_sup.                                                    *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             Une bonre inférieur : borne_inf                                *
+ *             Une borne supérieur : borne_sup                                *
+ *                                                                            *
+ * En sortie : Le nombre compris entre ces bornes.                            *
+ *                                                                            *
+ ******************************************************************************/
+
+static double Uniform(Simulation *sim, double borne_inf, double borne_sup)
+{
+
+    return (borne_inf + (borne_sup - borne_inf) * Tirage(sim));
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double Tirage(Simulation *sim)                                  *
+ *                                                                            *
+ * Donne le prochain nombre aléatoire uniforme de la simulation : un tirage   *
+ * imposé par SimulationFixerTirages s'il en reste, sinon le générateur (ou   *
+ * son complément à 1 pour une réplique antithétique).                        *
+ *                                                                            *
+ * En entrée : La simulation.                                                 *
+ *                                                                            *
+ * En sortie : Un nombre compris entre 0 et 1.                                *
+ *                                                                            *
+ ******************************************************************************/
+
+static double Tirage(Simulation *sim)
+{
+
+    double u;
+
+    if (sim->indice_premier < sim->nb_premiers)
+    {
+        return sim->premiers[sim->indice_premier++];
+    }
+
+    u = genrand_real1_r(&sim->generateur);
+
+    return sim->antithetique ? 1.0 - u : u;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                        Tirages agrégés par cohorte                         */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int NaissanceAgregee(Simulation *sim, int annee)                *
+ *                                                                            *
+ * Même loi que NaissanceSexuee, mais tirée sur toute la cohorte des lapines  *
+ * matures au lieu de lapine par lapine :                                     *
+ *   - le nombre de lapines de chaque classe de portées suit une loi          *
+ *     multinomiale, tirée classe par classe en binomiales conditionnelles ;  *
+ *   - le nombre de portées de chaque taille suit de même une multinomiale    *
+ *     équiprobable ;                                                         *
+ *   - le nombre de femelles parmi les bébés suit une binomiale.              *
+ * Chaque binomiale consomme exactement un tirage uniforme, même sur une      *
+ * cohorte vide, pour que le nombre de tirages d'une année soit fixe.         *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             L'année sur laquelle ont veut calculer le nombre de naissances *
+ *                                                                            *
+ * En sortie : SIMU_OK, les bébés sont rangés à l'âge 0 de l'année          *
+ *             SIMU_ERREUR_DEPASSEMENT si le nombre de portées ou de bébés ne *
+ *             tient pas sur 64 bits                                          *
+ *             SIMU_ERREUR_CONVERGENCE si une binomiale n'a pu être tirée.    *
+ *                                                                            *
+ ******************************************************************************/
+
+static int NaissanceAgregee(Simulation *sim, int annee)
+{
+
+    int i, nb_tailles, code;
+    unsigned long long n, reste,
+                       nb_femelles_mature = 0,
+                       nb_portees = 0,
+                       nb_bb = 0,
+                       nb_bb_femelles;
+    double proba, masse = 1.0, precedente = 0.0;
+    unsigned long long *femelles = Ligne(sim, annee, SIMU_FEMELLES);
+    unsigned long long *portees = sim->portees + (size_t)annee * SIMU_MAX_PORTEE;
+    const ParametresSimu *params = &sim->params;
+
+    memset(portees, 0, SIMU_MAX_PORTEE * sizeof(unsigned long long));
+
+    for (i = params->age_maturite; i < params->age_max; i++)
+    {
+        if (!AjouterProduit(&nb_femelles_mature, femelles[i], 1))
+        {
+            return SIMU_ERREUR_DEPASSEMENT;
+        }
+    }
+
+    FluxCommun(sim, annee, 0);
+
+    //  Classes de portées : la classe i a la probabilité repartition[i] -
+    //  repartition[i - 1], sauf la dernière qui prend le reste (comme nbPortee).
+    reste = nb_femelles_mature;
+    for (i = 0; i < params->nb_classes_portee - 1; i++)
+    {
+        proba = params->repartition_portee[i] - precedente;
+        precedente = params->repartition_portee[i];
+
+        code = Binomiale(sim, reste, masse > 0 ? proba / masse : 1.0, &n);
+        if (code != SIMU_OK)
+        {
+            return code;
+        }
+        masse -= proba;
+
+        portees[i] = n;
+        reste -= n;
+        if (!AjouterProduit(&nb_portees, n, (unsigned long long)(params->portee_min + i)))
+        {
+            return SIMU_ERREUR_DEPASSEMENT;
+        }
+    }
+    portees[params->nb_classes_portee - 1] = reste;
+    if (!AjouterProduit(&nb_portees, reste, (unsigned long long)(params->portee_min + params->nb_classes_portee - 1)))
+    {
+        return SIMU_ERREUR_DEPASSEMENT;
+    }
+
+    //  Taille des portées : équiprobable entre lapins_portee_min et
+    //  lapins_portee_max.
+    nb_tailles = params->lapins_portee_max - params->lapins_portee_min + 1;
+    reste = nb_portees;
+    for (i = 0; i < nb_tailles - 1; i++)
+    {
+        code = Binomiale(sim, reste, 1.0 / (nb_tailles - i), &n);
+        if (code != SIMU_OK)
+        {
+            return code;
+        }
+        reste -= n;
+        if (!AjouterProduit(&nb_bb, n, (unsigned long long)(params->lapins_portee_min + i)))
+        {
+            return SIMU_ERREUR_DEPASSEMENT;
+        }
+    }
+    if (!AjouterProduit(&nb_bb, reste, (unsigned long long)params->lapins_portee_max))
+    {
+        return SIMU_ERREUR_DEPASSEMENT;
+    }
+
+    code = Binomiale(sim, nb_bb, params->proba_femelle, &nb_bb_femelles);
+    if (code != SIMU_OK)
+    {
+        return code;
+    }
+
+    femelles[0] = nb_bb_femelles;
+    Ligne(sim, annee, SIMU_MALES)[0] = nb_bb - nb_bb_femelles;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void MortaliteAgregee(Simulation *sim, int annee)               *
+ *                                                                            *
+ * Même loi que Mortalite : les morts de chaque sexe et de chaque âge suivent *
+ * une binomiale sur la cohorte, tirée avec un seul tirage uniforme.          *
+ *                                                                            *
+ * En entrée : La simulation, dont les naissances de l'année sont déjà        *
+ *             calculées.                                                     *
+ *             L'année sur laquelle ont veut calculer la mortalité.           *
+ *                                                                            *
+ * En sortie : SIMU_OK, les lignes de morts de l'année sont remplies          *
+ *             SIMU_ERREUR_CONVERGENCE si une binomiale n'a pu être tirée.    *
+ *                                                                            *
+ ******************************************************************************/
+
+static int MortaliteAgregee(Simulation *sim, int annee)
+{
+
+    int i, j, code;
+    unsigned long long *vivants, *morts;
+    double survie, decroissance;
+    int lignes_vivants[2] = {SIMU_FEMELLES, SIMU_MALES};
+    int lignes_morts[2] = {SIMU_FEMELLES_MORTES, SIMU_MALES_MORTS};
+
+    for (i = 0; i < 2; i++)
+    {
+        vivants = Ligne(sim, annee, lignes_vivants[i]);
+        morts = Ligne(sim, annee, lignes_morts[i]);
+
+        decroissance = 0;
+        for (j = 0; j < sim->params.age_max; j++)
+        {
+            if (j == 0)
+            {
+                survie = sim->params.survie_petit;
+            }
+            else
+            {
+                if (j >= sim->params.age_senescence)
+                {
+                    decroissance += sim->params.decroissance_senescence;
+                }
+                survie = sim->params.survie_adulte - decroissance;
+            }
+
+            if (vivants[j] > 0)
+            {
+                FluxCommun(sim, annee, 1 + i * sim->params.age_max + j);
+            }
+            code = Binomiale(sim, vivants[j], 1.0 - survie, &morts[j]);
+            if (code != SIMU_OK)
+            {
+                return code;
+            }
+        }
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int Binomiale(Simulation *sim, unsigned long long n, double p,  *
+ *                          unsigned long long *succes)                       *
+ *                                                                            *
+ * Tire une loi binomiale B(n, p) par inversion de sa fonction de répartition *
+ * avec un seul tirage uniforme. Le résultat croît avec ce tirage, ce dont    *
+ * ont besoin les variables antithétiques et les plans stratifiés.            *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             Le nombre d'épreuves                                           *
+ *             La probabilité de succès (ramenée entre 0 et 1)                *
+ *             Le nombre de succès à remplir                                  *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_CONVERGENCE (voir BinomialeInverse).    *
+ *                                                                            *
+ ******************************************************************************/
+
+static int Binomiale(Simulation *sim, unsigned long long n, double p, unsigned long long *succes)
+{
+    return BinomialeInverse(n, p, Tirage(sim), succes);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int BinomialeInverse(unsigned long long n, double p, double u,  *
+ *                                 unsigned long long *quantile)              *
+ *                                                                            *
+ * Cherche le plus petit k tel que P(X <= k) >= u pour X de loi B(n, p) :     *
+ *   - tant que la variance n p (1 - p) reste sous VARIANCE_NORMALE, par      *
+ *     dichotomie sur la fonction de répartition exacte, calculée par         *
+ *     RepartitionBinomiale, en un nombre d'évaluations logarithmique en n ;  *
+ *   - au-delà, par l'approximation normale corrigée de Cornish-Fisher        *
+ *     (QuantileCornishFisher), dont l'erreur sur k est alors bien plus       *
+ *     petite qu'un individu.                                                 *
+ *                                                                            *
+ * En entrée : Le nombre d'épreuves                                           *
+ *             La probabilité de succès                                       *
+ *             Le tirage uniforme                                             *
+ *             Le quantile à remplir                                          *
+ *                                                                            *
+ * En sortie : SIMU_OK                                                        *
+ *             SIMU_ERREUR_CONVERGENCE si la fraction continue n'a pas        *
+ *             convergé, le quantile n'est alors pas rempli.                  *
+ *                                                                            *
+ ******************************************************************************/
+
+static int BinomialeInverse(unsigned long long n, double p, double u, unsigned long long *quantile)
+{
+
+    int code;
+    unsigned long long bas = 0, haut = n, milieu;
+    double repartition;
+
+    if (n == 0 || p <= 0)
+    {
+        *quantile = 0;
+        return SIMU_OK;
+    }
+    if (p >= 1)
+    {
+        *quantile = n;
+        return SIMU_OK;
+    }
+
+    //  Les bornes u = 0 et u = 1 n'ont pas de quantile normal fini.
+    if ((double)n * p * (1 - p) >= VARIANCE_NORMALE)
+    {
+        if (u <= 0)
+        {
+            *quantile = 0;
+        }
+        else if (u >= 1)
+        {
+            *quantile = n;
+        }
+        else
+        {
+            *quantile = QuantileCornishFisher(n, p, u);
+        }
+        return SIMU_OK;
+    }
+
+    while (bas < haut)
+    {
+        milieu = bas + (haut - bas) / 2;
+
+        code = RepartitionBinomiale(n, milieu, p, &repartition);
+        if (code != SIMU_OK)
+        {
+            return code;
+        }
+
+        if (repartition >= u)
+        {
+            haut = milieu;
+        }
+        else
+        {
+            bas = milieu + 1;
+        }
+    }
+
+    *quantile = bas;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : unsigned long long QuantileCornishFisher(unsigned long long n,  *
+ *                                                     double p, double u)    *
+ *                                                                            *
+ * Quantile u de B(n, p) par le développement de Cornish-Fisher : le quantile *
+ * normal z est corrigé par l'asymétrie et l'aplatissement de la loi, puis    *
+ * ramené sur les entiers avec la correction de continuité. L'erreur restante *
+ * sur k est de l'ordre de 1 / (n p (1 - p)), négligeable au-delà de          *
+ * VARIANCE_NORMALE. Le résultat croît avec u, comme le quantile exact.       *
+ *                                                                            *
+ * En entrée : Le nombre d'épreuves                                           *
+ *             La probabilité de succès, strictement entre 0 et 1             *
+ *             Le tirage uniforme, strictement entre 0 et 1                   *
+ *                                                                            *
+ * En sortie : Le quantile, entre 0 et n.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+static unsigned long long QuantileCornishFisher(unsigned long long n, double p, double u)
+{
+
+    double q = 1 - p;
+    double variance = (double)n * p * q;
+    double ecart_type = sqrt(variance);
+    double asymetrie = (q - p) / ecart_type;
+    double aplatissement = (1 - 6 * p * q) / variance;
+    double z = QuantileNormal(u);
+    double w, k;
+
+    w = z + asymetrie * (z * z - 1) / 6
+          + aplatissement * (z * z * z - 3 * z) / 24
+          - asymetrie * asymetrie * (2 * z * z * z - 5 * z) / 36;
+
+    //  P(X <= k) vaut environ G((k + 1/2 - n p) / écart type), on prend donc
+    //  le plus petit entier k tel que k + 1/2 >= n p + w écart type.
+    k = ceil((double)n * p + w * ecart_type - 0.5);
+
+    if (k <= 0)
+    {
+        return 0;
+    }
+    if (k >= (double)n)
+    {
+        return n;
+    }
+
+    return (unsigned long long)k < n ? (unsigned long long)k : n;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double QuantileNormal(double u)                                 *
+ *                                                                            *
+ * Quantile de la loi normale centrée réduite, par l'algorithme AS 241 de     *
+ * Wichura (fractions rationnelles, précision relative de l'ordre de 1e-16).  *
+ *                                                                            *
+ * En entrée : Le niveau u, strictement entre 0 et 1                          *
+ *                                                                            *
+ * En sortie : Le z tel que P(Z <= z) = u.                                    *
+ *                                                                            *
+ ******************************************************************************/
+
+static double QuantileNormal(double u)
+{
+
+    double q = u - 0.5, r, z;
+
+    if (fabs(q) <= 0.425)
+    {
+        r = 0.180625 - q * q;
+
+        return q * (((((((2.5090809287301226727e+3 * r + 3.3430575583588128105e+4) * r
+                         + 6.7265770927008700853e+4) * r + 4.5921953931549871457e+4) * r
+                       + 1.3731693765509461125e+4) * r + 1.9715909503065514427e+3) * r
+                     + 1.3314166789178437745e+2) * r + 3.3871328727963666080e+0)
+                 / (((((((5.2264952788528545610e+3 * r + 2.8729085735721942674e+4) * r
+                         + 3.9307895800092710610e+4) * r + 2.1213794301586595867e+4) * r
+                       + 5.3941960214247511077e+3) * r + 6.8718700749205790830e+2) * r
+                     + 4.2313330701600911252e+1) * r + 1.0);
+    }
+
+    r = sqrt(-log(q < 0 ? u : 1 - u));
+
+    if (r <= 5)
+    {
+        r -= 1.6;
+        z = (((((((7.74545014278341407640e-4 * r + 2.27238449892691845833e-2) * r
+                  + 2.41780725177450611770e-1) * r + 1.27045825245236838258e+0) * r
+                + 3.64784832476320460504e+0) * r + 5.76949722146069140550e+0) * r
+              + 4.63033784615654529590e+0) * r + 1.42343711074968357734e+0)
+          / (((((((1.05075007164441684324e-9 * r + 5.47593808499534494600e-4) * r
+                  + 1.51986665636164571966e-2) * r + 1.48103976427480074590e-1) * r
+                + 6.89767334985100004550e-1) * r + 1.67638483018380384940e+0) * r
+              + 2.05319162663775882187e+0) * r + 1.0);
+    }
+    else
+    {
+        r -= 5;
+        z = (((((((2.01033439929228813265e-7 * r + 2.71155556874348757815e-5) * r
+                  + 1.24266094738807843860e-3) * r + 2.65321895265761230930e-2) * r
+                + 2.96560571828504891230e-1) * r + 1.78482653991729133580e+0) * r
+              + 5.46378491116411436990e+0) * r + 6.65790464350110377720e+0)
+          / (((((((2.04426310338993978564e-15 * r + 1.42151175831644588870e-7) * r
+                  + 1.84631831751005468180e-5) * r + 7.86869131145613259100e-4) * r
+                + 1.48753612908506148525e-2) * r + 1.36929880922735805310e-1) * r
+              + 5.99832206555887937690e-1) * r + 1.0);
+    }
+
+    return q < 0 ? -z : z;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int RepartitionBinomiale(unsigned long long n,                  *
+ *                  unsigned long long k, double p, double *repartition)      *
+ *                                                                            *
+ * P(X <= k) pour X de loi B(n, p). Pour p > 1/2, on passe par n - X, de loi  *
+ * B(n, 1 - p) : QueueBinomiale ne voit ainsi jamais que la plus petite des   *
+ * deux probabilités, qui est exacte (1 - p l'est pour p >= 1/2).             *
+ *                                                                            *
+ * En entrée : Le nombre d'épreuves                                           *
+ *             Le nombre de succès k                                          *
+ *             La probabilité de succès, strictement entre 0 et 1             *
+ *             La probabilité à remplir                                       *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_CONVERGENCE.                            *
+ *                                                                            *
+ ******************************************************************************/
+
+static int RepartitionBinomiale(unsigned long long n, unsigned long long k, double p, double *repartition)
+{
+    if (k >= n)
+    {
+        *repartition = 1;
+        return SIMU_OK;
+    }
+
+    //  P(X <= k) = P(n - X > n - k - 1).
+    if (p > 0.5)
+    {
+        return QueueBinomiale(n, n - k - 1, 1 - p, 1, repartition);
+    }
+
+    return QueueBinomiale(n, k, p, 0, repartition);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int QueueBinomiale(unsigned long long n, unsigned long long k,  *
+ *                  double p, int superieure, double *queue)                  *
+ *                                                                            *
+ * P(X <= k), ou P(X > k) si superieure est vrai, pour X de loi B(n, p) avec  *
+ * p <= 1/2 et k < n. La queue la plus petite est calculée directement, pour  *
+ * garder sa précision relative, et l'autre en est le complément :            *
+ *   - au-dessus de la moyenne, P(X > k) est la fonction bêta incomplète      *
+ *     régularisée I_p(k + 1, n - k), dont la fraction continue               *
+ *     (FractionBeta) converge vite de ce côté. Son facteur                   *
+ *     p^(k+1) (1-p)^(n-k) / B est calculé en logarithme par la forme de      *
+ *     Loader (DeviationBinomiale et EcartStirling) : avec des lgamma de      *
+ *     l'ordre de n ln n, son exponentielle perdrait toute précision dès les  *
+ *     grandes cohortes ;                                                     *
+ *   - en dessous, P(X <= k) est la somme des P(X = j), j <= k, qui           *
+ *     décroissent vite. La fraction continue en 1 - p y perdrait de l'ordre  *
+ *     de n / racine(n p) fois la précision du double.                        *
+ *                                                                            *
+ * En entrée : Le nombre d'épreuves                                           *
+ *             Le nombre de succès k, inférieur à n                           *
+ *             La probabilité de succès, entre 0 et 1/2                       *
+ *             La queue voulue                                                *
+ *             La probabilité à remplir                                       *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_CONVERGENCE.                            *
+ *                                                                            *
+ ******************************************************************************/
+
+static int QueueBinomiale(unsigned long long n, unsigned long long k, double p, int superieure, double *queue)
+{
+
+    int code;
+    unsigned long long j;
+    double a, b, s, facteur, fraction, terme, somme;
+
+    a = (double)(n - k);
+    b = (double)k + 1;
+    s = (double)n + 1;
+
+    if (p * (s + 2) <= b + 1)
+    {
+        code = FractionBeta(b, a, p, &fraction);
+        if (code != SIMU_OK)
+        {
+            return code;
+        }
+
+        facteur = exp(-DeviationBinomiale(b, b - s * p) - DeviationBinomiale(a, s * p - b)
+                      + 0.5 * log(a * b / s) - LOG_RACINE_2PI
+                      + EcartStirling(s) - EcartStirling(a) - EcartStirling(b));
+
+        *queue = superieure ? facteur * fraction / b : 1 - facteur * fraction / b;
+
+        return SIMU_OK;
+    }
+
+    //  Le rapport P(X = j - 1) / P(X = j) vaut j (1 - p) / ((n - j + 1) p),
+    //  inférieur à 1 sous la moyenne.
+    terme = ProbabiliteBinomiale(n, k, p);
+    somme = terme;
+    for (j = k; j > 0 && terme > somme * 1e-17; j--)
+    {
+        terme *= (double)j * (1 - p) / ((double)(n - j + 1) * p);
+        somme += terme;
+    }
+
+    *queue = superieure ? 1 - somme : somme;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double ProbabiliteBinomiale(unsigned long long n,               *
+ *                                        unsigned long long k, double p)     *
+ *                                                                            *
+ * P(X = k) pour X de loi B(n, p), p <= 1/2, par la forme de Loader : les     *
+ * lgamma sont remplacés par leurs écarts à la formule de Stirling, et les    *
+ * puissances par des déviances qui ne s'annulent pas entre elles.            *
+ *                                                                            *
+ ******************************************************************************/
+
+static double ProbabiliteBinomiale(unsigned long long n, unsigned long long k, double p)
+{
+
+    double x = (double)k, y = (double)(n - k), ecart = (double)k - (double)n * p;
+
+    if (k == 0)
+    {
+        return exp((double)n * log1p(-p));
+    }
+
+    return exp(EcartStirling((double)n) - EcartStirling(x) - EcartStirling(y)
+               - DeviationBinomiale(x, ecart) - DeviationBinomiale(y, -ecart))
+           * sqrt((double)n / (x * y)) * exp(-LOG_RACINE_2PI);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double DeviationBinomiale(double x, double ecart)               *
+ *                                                                            *
+ * Déviance x ln(x / m) + m - x, avec m = x - ecart, calculée par sa série    *
+ * quand x et m sont proches pour éviter l'annulation des deux termes.        *
+ *                                                                            *
+ * En entrée : Le point x, strictement positif                                *
+ *             L'écart x - m, calculé sans perte par l'appelant               *
+ *                                                                            *
+ * En sortie : La déviance, positive.                                         *
+ *                                                                            *
+ ******************************************************************************/
+
+static double DeviationBinomiale(double x, double ecart)
+{
+
+    int j;
+    double m = x - ecart, v, v2, terme, somme, suivante;
+
+    if (fabs(ecart) >= 0.1 * (x + m))
+    {
+        return x * log(x / m) + m - x;
+    }
+
+    v = ecart / (x + m);
+    v2 = v * v;
+    somme = ecart * v;
+    terme = 2 * x * v;
+
+    for (j = 1; j < 1000; j++)
+    {
+        terme *= v2;
+        suivante = somme + terme / (2 * j + 1);
+        if (suivante == somme)
+        {
+            break;
+        }
+        somme = suivante;
+    }
+
+    return somme;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : double EcartStirling(double z)                                  *
+ *                                                                            *
+ * Erreur de la formule de Stirling : lgamma(z + 1) - (z + 1/2) ln z + z -    *
+ * ln(2 pi) / 2, par lgamma pour les petits z et par sa série asymptotique    *
+ * au-delà de 15, où elle est exacte à la précision du double.                *
+ *                                                                            *
+ ******************************************************************************/
+
+static double EcartStirling(double z)
+{
+
+    double z2;
+
+    if (z <= 15)
+    {
+        return lgamma(z + 1) - (z + 0.5) * log(z) + z - LOG_RACINE_2PI;
+    }
+
+    z2 = z * z;
+
+    return (1.0 / 12 - (1.0 / 360 - (1.0 / 1260 - (1.0 / 1680 - 1.0 / 1188 / z2) / z2) / z2) / z2) / z;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int FractionBeta(double a, double b, double x,                  *
+ *                             double *fraction)                              *
+ *                                                                            *
+ * Évalue la fraction continue de la fonction bêta incomplète (méthode de     *
+ * Lentz). Le nombre de termes nécessaires croît comme la racine de la        *
+ * variance de la binomiale : quelques centaines sous VARIANCE_NORMALE.       *
+ *                                                                            *
+ * En entrée : Les paramètres a et b, strictement positifs                    *
+ *             Le point x                                                     *
+ *             La fraction à remplir                                          *
+ *                                                                            *
+ * En sortie : SIMU_OK                                                        *
+ *             SIMU_ERREUR_CONVERGENCE si MAX_TERMES_FRACTION termes n'ont    *
+ *             pas suffi.                                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+static int FractionBeta(double a, double b, double x, double *fraction)
+{
+
+    int m;
+    double aa, c, d, delta, h, m2;
+    const double epsilon = 1e-15, minimum = 1e-300;
+
+    c = 1;
+    d = 1 - (a + b) * x / (a + 1);
+    if (fabs(d) < minimum)
+    {
+        d = minimum;
+    }
+    d = 1 / d;
+    h = d;
+
+    for (m = 1; m <= MAX_TERMES_FRACTION; m++)
+    {
+        m2 = 2.0 * m;
+
+        //  Terme pair de la fraction.
+        aa = m * (b - m) * x / ((a - 1 + m2) * (a + m2));
+        d = 1 + aa * d;
+        if (fabs(d) < minimum)
+        {
+            d = minimum;
+        }
+        c = 1 + aa / c;
+        if (fabs(c) < minimum)
+        {
+            c = minimum;
+        }
+        d = 1 / d;
+        h *= d * c;
+
+        //  Terme impair.
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + 1 + m2));
+        d = 1 + aa * d;
+        if (fabs(d) < minimum)
+        {
+            d = minimum;
+        }
+        c = 1 + aa / c;
+        if (fabs(c) < minimum)
+        {
+            c = minimum;
+        }
+        d = 1 / d;
+        delta = d * c;
+        h *= delta;
+
+        if (fabs(delta - 1) < epsilon)
+        {
+            *fraction = h;
+            return SIMU_OK;
+        }
+    }
+
+    return SIMU_ERREUR_CONVERGENCE;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AjouterProduit(unsigned long long *total,                   *
+ *                  unsigned long long n, unsigned long long facteur)         *
+ *                                                                            *
+ * Ajoute n * facteur à un total, si le résultat tient sur 64 bits.           *
+ *                                                                            *
+ * En sortie : 1 si l'addition a été faite                                    *
+ *             0 si elle aurait dépassé, le total n'est alors pas modifié.    *
+ *                                                                            *
+ ******************************************************************************/
+
+static int AjouterProduit(unsigned long long *total, unsigned long long n, unsigned long long facteur)
+{
+    if (facteur != 0 && n > (ULLONG_MAX - *total) / facteur)
+    {
+        return 0;
+    }
+
+    *total += n * facteur;
+
+    return 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int EffectifsRepresentables(const Simulation *sim, int annee)   *
+ *                                                                            *
+ * Vérifie que la population vivante d'une année, naissances comprises, tient *
+ * sur 64 bits. Les années suivantes n'en gardent que des survivants : les    *
+ * sommes de cohortes faites par les clients restent alors exactes.           *
+ *                                                                            *
+ * En sortie : 1 si la somme de toutes les cohortes vivantes tient            *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static int EffectifsRepresentables(const Simulation *sim, int annee)
+{
+
+    int age;
+    unsigned long long total = 0;
+    const unsigned long long *femelles = Ligne(sim, annee, SIMU_FEMELLES);
+    const unsigned long long *males = Ligne(sim, annee, SIMU_MALES);
+
+    for (age = 0; age < sim->params.age_max; age++)
+    {
+        if (!AjouterProduit(&total, femelles[age], 1) || !AjouterProduit(&total, males[age], 1))
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void AnnulerAnnee(Simulation *sim, int annee)                   *
+ *                                                                            *
+ * Remet la dernière année dans l'état où elle était avant le calcul de ses   *
+ * naissances : générateur, paramètres et tirages imposés repris de son point *
+ * de reprise, naissances, morts et portées effacées.                         *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             La dernière année, dont le point de reprise est enregistré     *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+static void AnnulerAnnee(Simulation *sim, int annee)
+{
+    sim->generateur = sim->reprises[annee].generateur;
+    sim->params = sim->reprises[annee].params;
+    sim->indice_premier = sim->reprises[annee].indice_premier;
+
+    Ligne(sim, annee, SIMU_FEMELLES)[0] = 0;
+    Ligne(sim, annee, SIMU_MALES)[0] = 0;
+    memset(Ligne(sim, annee, SIMU_FEMELLES_MORTES), 0, sim->params.age_max * sizeof(unsigned long long));
+    memset(Ligne(sim, annee, SIMU_MALES_MORTS), 0, sim->params.age_max * sizeof(unsigned long long));
+    memset(sim->portees + (size_t)annee * SIMU_MAX_PORTEE, 0, SIMU_MAX_PORTEE * sizeof(unsigned long long));
+}
+
+#ifdef SIMU_FORME_FIXE
+
+/* -------------------------------------------------------------------------- */
+/*                   Noyaux spécialisés pour une forme fixe                   */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Les fonctions suivantes font exactement les mêmes tirages, dans le même    *
+ * ordre, que NaissanceSexuee, Mortalite et Evolution, mais avec les          *
+ * constantes de simu_forme.h au lieu des paramètres de la simulation. Le     *
+ * compilateur peut ainsi dérouler les boucles sur les âges et calculer les   *
+ * seuils de survie à l'avance.                                               *
+ *                                                                            *
+ ******************************************************************************/
+
+static const double repartition_fixe[] = SIMU_FORME_REPARTITION_PORTEE;
+
+#define NB_CLASSES_FIXE ((int)(sizeof(repartition_fixe) / sizeof(repartition_fixe[0])))
+
+//  Les noyaux indexent les portées et les classes d'âge avec ces constantes
+//  sans les vérifier : une forme redéfinie à la compilation doit tenir dans
+//  les tampons de la simulation.
+_Static_assert(NB_CLASSES_FIXE >= 1 && NB_CLASSES_FIXE <= SIMU_MAX_PORTEE,
+               "SIMU_FORME_REPARTITION_PORTEE doit avoir entre 1 et SIMU_MAX_PORTEE classes");
+_Static_assert(SIMU_FORME_AGE_MAX >= 2 && SIMU_FORME_AGE_MATURITE >= 1 &&
+               SIMU_FORME_AGE_MATURITE < SIMU_FORME_AGE_MAX,
+               "SIMU_FORME_AGE_MATURITE doit être entre 1 et SIMU_FORME_AGE_MAX - 1");
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int FormeFixe(const ParametresSimu *params)                     *
+ *                                                                            *
+ * En sortie : 1 si les paramètres sont exactement ceux de la forme compilée  *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static int FormeFixe(const ParametresSimu *params)
+{
+
+    int i;
+
+    if (params->age_max != SIMU_FORME_AGE_MAX ||
+        params->age_maturite != SIMU_FORME_AGE_MATURITE ||
+        params->age_senescence != SIMU_FORME_AGE_SENESCENCE ||
+        params->survie_petit != SIMU_FORME_SURVIE_PETIT ||
+        params->survie_adulte != SIMU_FORME_SURVIE_ADULTE ||
+        params->decroissance_senescence != SIMU_FORME_DECROISSANCE ||
+        params->proba_femelle != SIMU_FORME_PROBA_FEMELLE ||
+        params->portee_min != SIMU_FORME_PORTEE_MIN ||
+        params->nb_classes_portee != NB_CLASSES_FIXE ||
+        params->lapins_portee_min != SIMU_FORME_LAPINS_PORTEE_MIN ||
+        params->lapins_portee_max != SIMU_FORME_LAPINS_PORTEE_MAX ||
+        params->tirages_agreges)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < NB_CLASSES_FIXE; i++)
+    {
+        if (params->repartition_portee[i] != repartition_fixe[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void NaissanceSexueeFixe(Simulation *sim, int annee)            *
+ *                                                                            *
+ * Version spécialisée de NaissanceSexuee : nbPortee, nbLapinPortee et        *
+ * SexeLapin y sont écrits en ligne avec des bornes constantes.               *
+ *                                                                            *
+ ******************************************************************************/
+
+static void NaissanceSexueeFixe(Simulation *sim, int annee)
+{
+
+    int j, k, nb_portee, nb_bb_portee;
+    unsigned long long i,
+                       nb_femelles_mature = 0,
+                       nb_bb_males = 0,
+                       nb_bb_tot = 0;
+    unsigned long long *femelles = Ligne(sim, annee, SIMU_FEMELLES);
+    unsigned long long *portees = sim->portees + (size_t)annee * SIMU_MAX_PORTEE;
+    mt_state *generateur = &sim->generateur;
+    double val;
+
+    memset(portees, 0, SIMU_MAX_PORTEE * sizeof(unsigned long long));
+
+    SIMU_DEROULER
+    for (k = SIMU_FORME_AGE_MATURITE; k < SIMU_FORME_AGE_MAX; k++)
+    {
+        nb_femelles_mature += femelles[k];
+    }
+
+    FluxCommun(sim, annee, 0);
+    for (i = 0; i < nb_femelles_mature; i++)
+    {
+
+        val = genrand_real1_r(generateur);
+        nb_portee = SIMU_FORME_PORTEE_MIN + NB_CLASSES_FIXE - 1;
+
+        SIMU_DEROULER
+        for (j = 0; j < NB_CLASSES_FIXE - 1; j++)
+        {
+            if (val <= repartition_fixe[j])
+            {
+                nb_portee = SIMU_FORME_PORTEE_MIN + j;
+                break;
+            }
+        }
+        portees[nb_portee - SIMU_FORME_PORTEE_MIN]++;
+
+        for (j = 0; j < nb_portee; j++)
+        {
+
+            nb_bb_portee = (int)((SIMU_FORME_LAPINS_PORTEE_MIN - 1.0) +
+                                 (SIMU_FORME_LAPINS_PORTEE_MAX - (SIMU_FORME_LAPINS_PORTEE_MIN - 1.0)) *
+                                     genrand_real1_r(generateur) +
+                                 1);
+
+            for (k = 0; k < nb_bb_portee; k++)
+            {
+                nb_bb_males += genrand_real1_r(generateur) > SIMU_FORME_PROBA_FEMELLE;
+            }
+
+            nb_bb_tot += nb_bb_portee;
+        }
+    }
+
+    //  On compte les mâles au passage, les femelles sont le reste.
+    femelles[0] = nb_bb_tot - nb_bb_males;
+    Ligne(sim, annee, SIMU_MALES)[0] = nb_bb_males;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void MortaliteFixe(Simulation *sim, int annee)                  *
+ *                                                                            *
+ * Version spécialisée de Mortalite : la boucle sur les âges est déroulée, le *
+ * seuil de survie de chaque âge devient une constante.                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static void MortaliteFixe(Simulation *sim, int annee)
+{
+
+    int i, j;
+    unsigned long long k, nb_morts, *vivants, *morts;
+    double decroissance, seuil;
+    mt_state *generateur = &sim->generateur;
+    int lignes_vivants[2] = {SIMU_FEMELLES, SIMU_MALES};
+    int lignes_morts[2] = {SIMU_FEMELLES_MORTES, SIMU_MALES_MORTS};
+
+    for (i = 0; i < 2; i++)
+    {
+        vivants = Ligne(sim, annee, lignes_vivants[i]);
+        nb_morts = 0;
+
+        if (vivants[0] > 0)
+        {
+            FluxCommun(sim, annee, 1 + i * SIMU_FORME_AGE_MAX);
+        }
+        for (k = 0; k < vivants[0]; k++)
+        {
+            nb_morts += genrand_real1_r(generateur) >= SIMU_FORME_SURVIE_PETIT;
+        }
+
+        Ligne(sim, annee, lignes_morts[i])[0] = nb_morts;
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        vivants = Ligne(sim, annee, lignes_vivants[i]);
+        morts = Ligne(sim, annee, lignes_morts[i]);
+
+        //  Une fois la boucle déroulée, decroissance et seuil ne dépendent
+        //  plus que de constantes : le compilateur les calcule lui-même, avec
+        //  les mêmes additions successives que Mortalite.
+        decroissance = 0;
+        SIMU_DEROULER
+        for (j = 1; j < SIMU_FORME_AGE_MAX; j++)
+        {
+
+            if (j >= SIMU_FORME_AGE_SENESCENCE)
+            {
+                decroissance += SIMU_FORME_DECROISSANCE;
+            }
+            seuil = SIMU_FORME_SURVIE_ADULTE - decroissance;
+
+            if (vivants[j] > 0)
+            {
+                FluxCommun(sim, annee, 1 + i * SIMU_FORME_AGE_MAX + j);
+            }
+            nb_morts = 0;
+            for (k = 0; k < vivants[j]; k++)
+            {
+                nb_morts += genrand_real1_r(generateur) >= seuil;
+            }
+            morts[j] = nb_morts;
+        }
+    }
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void VieillissementFixe(Simulation *sim, int annee)             *
+ *                                                                            *
+ * Remplit les survivants de l'année à partir de l'année précédente, comme la *
+ * fin d'Evolution, avec une boucle déroulée.                                 *
+ *                                                                            *
+ ******************************************************************************/
+
+static void VieillissementFixe(Simulation *sim, int annee)
+{
+
+    int i;
+    const unsigned long long *femelles = Ligne(sim, annee - 1, SIMU_FEMELLES),
+                             *femelles_mortes = Ligne(sim, annee - 1, SIMU_FEMELLES_MORTES),
+                             *males = Ligne(sim, annee - 1, SIMU_MALES),
+                             *males_morts = Ligne(sim, annee - 1, SIMU_MALES_MORTS);
+    unsigned long long *nouvelles_femelles = Ligne(sim, annee, SIMU_FEMELLES),
+                       *nouveaux_males = Ligne(sim, annee, SIMU_MALES);
+
+    SIMU_DEROULER
+    for (i = 1; i < SIMU_FORME_AGE_MAX; i++)
+    {
+        nouvelles_femelles[i] = femelles[i - 1] - femelles_mortes[i - 1];
+        nouveaux_males[i] = males[i - 1] - males_morts[i - 1];
+    }
+}
+
+#endif
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int AllocationTableau(Simulation *sim, int nb_annee)            *
+ *                                                                            *
+ * Permet d'agrandir les tampons de la simulation (tableau, portées et points *
+ * de reprise) pour qu'ils puissent contenir au moins nb_annee années. La     *
+ * capacité est doublée pour que les appels successifs à SimulationAvancer    *
+ * restent peu coûteux, sans dépasser INT_MAX. Les tailles en octets sont     *
+ * calculées en size_t et vérifiées avant chaque realloc. Les nouvelles       *
+ * années sont mises à zéro.                                                  *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             Le nombre d'années voulu                                       *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_MEMOIRE.                                *
+ *                                                                            *
+ ******************************************************************************/
+
+static int AllocationTableau(Simulation *sim, int nb_annee)
+{
+    unsigned long long *nouveau, *portees;
+    Reprise *reprises;
+    size_t taille_annee = TailleAnnee(sim);
+    size_t capacite = sim->capacite > 0 ? (size_t)sim->capacite : 1;
+
+    if (nb_annee <= sim->capacite)
+    {
+        return SIMU_OK;
+    }
+
+    while (capacite < (size_t)nb_annee)
+    {
+        //  Au-delà de INT_MAX / 2 on ne double plus, on prend juste ce qu'il
+        //  faut : la capacité est rangée dans un int.
+        capacite = capacite <= INT_MAX / 2 ? capacite * 2 : (size_t)nb_annee;
+    }
+
+    if (capacite > SIZE_MAX / sizeof(unsigned long long) / taille_annee ||
+        capacite > SIZE_MAX / sizeof(unsigned long long) / SIMU_MAX_PORTEE ||
+        capacite > SIZE_MAX / sizeof(Reprise))
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    nouveau = (unsigned long long *)realloc(sim->tableau, capacite * taille_annee * sizeof(unsigned long long));
+    if (nouveau == NULL)
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    memset(nouveau + (size_t)sim->capacite * taille_annee, 0,
+           (capacite - (size_t)sim->capacite) * taille_annee * sizeof(unsigned long long));
+    sim->tableau = nouveau;
+
+    portees = (unsigned long long *)realloc(sim->portees, capacite * SIMU_MAX_PORTEE * sizeof(unsigned long long));
+    if (portees == NULL)
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+    sim->portees = portees;
+
+    reprises = (Reprise *)realloc(sim->reprises, capacite * sizeof(Reprise));
+    if (reprises == NULL)
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    sim->reprises = reprises;
+    sim->capacite = (int)capacite;
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void FluxCommun(Simulation *sim, int annee, int tirage)         *
+ *                                                                            *
+ * Avec le paramètre flux_communs, réinitialise le générateur pour un tirage  *
+ * donné d'une année : 0 pour les naissances, 1 + sexe * age_max + âge pour   *
+ * la mortalité. La clé contient la graine, le numéro de réplique, l'année et *
+ * le tirage, si bien que chaque événement garde ses nombres aléatoires quand *
+ * les paramètres changent. Sans ce paramètre, ne fait rien. Les tirages      *
+ * d'une cohorte vide sont sautés, ce qui ne change rien aux autres.          *
+ *                                                                            *
+ * En entrée : La simulation                                                  *
+ *             L'année                                                        *
+ *             Le numéro du tirage                                            *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+static void FluxCommun(Simulation *sim, int annee, int tirage)
+{
+
+    unsigned long cle[6];
+
+    if (!sim->params.flux_communs)
+    {
+        return;
+    }
+
+    cle[0] = sim->params.graine & 0xffffffffUL;
+    cle[1] = ((unsigned long long)sim->params.graine >> 32) & 0xffffffffUL;
+    cle[2] = sim->replique & 0xffffffffUL;
+    cle[3] = (sim->replique >> 32) & 0xffffffffUL;
+    cle[4] = (unsigned long)annee;
+    cle[5] = (unsigned long)tirage;
+    init_by_array_r(&sim->generateur, cle, 6);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : size_t TailleAnnee(const Simulation *sim)                       *
+ *                                                                            *
+ * En sortie : Le nombre de cases d'une année du tableau.                     *
+ *                                                                            *
+ ******************************************************************************/
+
+static size_t TailleAnnee(const Simulation *sim)
+{
+    return (size_t)SIMU_NB_LIGNES * sim->params.age_max;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : unsigned long long *Ligne(const Simulation *sim, int annee,     *
+ *                                      int ligne)                            *
+ *                                                                            *
+ * En sortie : Le début de la ligne [annee][ligne] du tampon.                 *
+ *                                                                            *
+ ******************************************************************************/
+
+static unsigned long long *Ligne(const Simulation *sim, int annee, int ligne)
+{
+    return sim->tableau + (size_t)annee * TailleAnnee(sim) + (size_t)ligne * sim->params.age_max;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int ParametresValides(const ParametresSimu *params)             *
+ *                                                                            *
+ * La répartition des portées doit être une fonction de répartition : des     *
+ * valeurs entre 0 et 1, croissantes, dont la dernière vaut exactement 1.     *
+ * nbPortee s'en sert comme seuils et NaissanceAgregee en tire les            *
+ * probabilités de chaque classe, qui doivent être positives.                 *
+ *                                                                            *
+ * En sortie : 1 si les paramètres décrivent un modèle cohérent               *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static int ParametresValides(const ParametresSimu *params)
+{
+
+    int i;
+    double precedente = 0.0;
+
+    if (!(params->age_max >= 2 &&
+          params->age_maturite >= 1 && params->age_maturite < params->age_max &&
+          params->age_senescence >= 1 &&
+          params->survie_petit >= 0 && params->survie_petit <= 1 &&
+          params->survie_adulte >= 0 && params->survie_adulte <= 1 &&
+          params->decroissance_senescence >= 0 &&
+          params->proba_femelle >= 0 && params->proba_femelle <= 1 &&
+          params->portee_min >= 0 &&
+          params->nb_classes_portee >= 1 && params->nb_classes_portee <= SIMU_MAX_PORTEE &&
+          params->lapins_portee_min >= 1 && params->lapins_portee_max >= params->lapins_portee_min))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < params->nb_classes_portee; i++)
+    {
+        //  Écrit ainsi pour rejeter aussi les NaN.
+        if (!(params->repartition_portee[i] >= precedente && params->repartition_portee[i] <= 1))
+        {
+            return 0;
+        }
+        precedente = params->repartition_portee[i];
+    }
+
+    return precedente == 1.0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int CopierParametres(ParametresSimu *destination,               *
+ *                                 const ParametresSimu *source)              *
+ *                                                                            *
+ * Copie les paramètres donnés par un appelant. Si celui-ci a été compilé     *
+ * avec une version plus ancienne de simu_lapin.h, sa structure est plus      *
+ * courte : les champs qui lui manquent gardent leur valeur par défaut. Les   *
+ * réserves, qu'un ancien appelant a pu laisser quelconques, sont remises à   *
+ * zéro.                                                                      *
+ *                                                                            *
+ * En entrée : Les paramètres à remplir                                       *
+ *             Les paramètres de l'appelant                                   *
+ *                                                                            *
+ * En sortie : 1 si les paramètres obtenus sont valides                       *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+static int CopierParametres(ParametresSimu *destination, const ParametresSimu *source)
+{
+
+    size_t taille = source->taille;
+
+    if (taille < SIMU_TAILLE_PARAMETRES_V1)
+    {
+        return 0;
+    }
+    if (taille > sizeof(ParametresSimu))
+    {
+        taille = sizeof(ParametresSimu);
+    }
+
+    ParametresSimuDefautTaille(destination, sizeof(ParametresSimu));
+    memcpy(destination, source, taille);
+    destination->taille = sizeof(ParametresSimu);
+    destination->reserve_v2 = 0;
+    destination->reserve_v3 = 0;
+
+    //  Un appelant de la version 2 s'arrête au remplissage qui suit
+    //  flux_communs : il n'a pas de tirages_agreges.
+    if (taille <= SIMU_TAILLE_PARAMETRES_V2)
+    {
+        destination->tirages_agreges = 0;
+    }
+
+    return ParametresValides(destination);
+}
@@ -0,0 +1,223 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Bibliothèque : simu_lapin.h                                           *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Interface C publique du moteur de simulation de la population de      *
+ *      lapins. Une simulation est manipulée au travers d'une poignée         *
+ *      opaque 'Simulation' : on la crée à partir de paramètres, on la fait   *
+ *      avancer d'un certain nombre d'années, on lit les cohortes             *
+ *      directement dans ses tampons internes puis on la détruit.             *
+ *                                                                            *
+ *      La bibliothèque se compile comme suit, en C99 sur n'importe quel      *
+ *      système :                                                             *
+ *      gcc -Wall -O2 -fPIC -c simu_lapin.c mt19937ar.c                       *
+ *      ar rcs libsimu_lapin.a simu_lapin.o mt19937ar.o                       *
+ *      gcc -shared -o libsimu_lapin.so simu_lapin.o mt19937ar.o -lm          *
+ *                                                                            *
+ *      Le stockage des trajectoires sur disque, qui demande mmap, est une    *
+ *      bibliothèque à part, simu_traj (voir trajectoires.h).                 *
+ *                                                                            *
+ *      Les programmes liés à la version statique ajoutent -lm (les tirages   *
+ *      agrégés utilisent lgamma, exp et log).                                *
+ *                                                                            *
+ *      Avec -DSIMU_FORME_FIXE, la bibliothèque contient en plus des noyaux   *
+ *      spécialisés pour la forme de modèle décrite dans simu_forme.h.        *
+ *                                                                            *
+ *      L'ABI est stable tant que SIMU_VERSION_ABI ne change pas : les        *
+ *      structures publiques ne font que grandir par la fin et leur champ     *
+ *      'taille' permet à la bibliothèque de reconnaître un appelant plus     *
+ *      ancien.                                                               *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef SIMU_LAPIN_H
+#define SIMU_LAPIN_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if defined(__GNUC__)
+#define SIMU_API __attribute__((visibility("default")))
+#else
+#define SIMU_API
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*                           Constantes publiques                             */
+/* -------------------------------------------------------------------------- */
+
+#define SIMU_VERSION_ABI 1
+
+//  Nombre maximum de classes dans la répartition du nombre de portées.
+#define SIMU_MAX_PORTEE 16
+
+//  Nombre maximum de tirages imposés par SimulationFixerTirages.
+#define SIMU_MAX_PREMIERS 256
+
+//  Lignes d'une année du tableau de résultats (voir simu_fin.c).
+#define SIMU_FEMELLES 0
+#define SIMU_FEMELLES_MORTES 1
+#define SIMU_MALES 2
+#define SIMU_MALES_MORTS 3
+#define SIMU_NB_LIGNES 4
+
+//  Codes de retour des fonctions de la bibliothèque.
+#define SIMU_OK 0
+#define SIMU_ERREUR_PARAMETRE -1
+#define SIMU_ERREUR_MEMOIRE -2
+#define SIMU_ERREUR_FICHIER -3
+#define SIMU_ERREUR_DEPASSEMENT -4
+#define SIMU_ERREUR_CONVERGENCE -5
+
+/* -------------------------------------------------------------------------- */
+/*                             Types publics                                  */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Paramètres du modèle. Toujours les initialiser avec ParametresSimuDefaut   *
+ * avant de modifier les champs voulus, les valeurs par défaut sont celles    *
+ * du programme d'origine. Le champ taille reçoit alors la taille de la       *
+ * structure de l'appelant : la bibliothèque ne lit ni n'écrit au-delà, et    *
+ * donne leur valeur par défaut aux champs qu'il ne connaît pas.              *
+ *                                                                            *
+ * repartition_portee contient la répartition cumulée du nombre de portées :  *
+ * la classe i correspond à (portee_min + i) portées. Les valeurs croissent   *
+ * entre 0 et 1 et la dernière classe vaut exactement 1, sinon les            *
+ * paramètres sont refusés.                                                   *
+ *                                                                            *
+ * Avec flux_communs, le générateur est réinitialisé pour chaque année et     *
+ * chaque tirage de cette année (les naissances, puis la mortalité de chaque  *
+ * sexe et de chaque âge) à partir de la graine et du numéro de réplique.     *
+ * Deux simulations dont les paramètres diffèrent un peu utilisent alors les  *
+ * mêmes nombres aléatoires pour les mêmes événements, ce qui rend leur       *
+ * différence beaucoup moins bruitée. Les résultats ne sont plus ceux du      *
+ * flux unique par défaut.                                                    *
+ *                                                                            *
+ * Avec tirages_agreges, chaque année est tirée par lois binomiales sur les   *
+ * cohortes au lieu d'un tirage par lapin, et une année consomme toujours le  *
+ * même nombre de tirages uniformes (voir SimulationTiragesParAnnee), quelle  *
+ * que soit la taille de la population. C'est ce qui permet de piloter ces    *
+ * tirages par un plan d'expérience (variables antithétiques, stratification, *
+ * suites de Sobol). La loi de la trajectoire est la même tant que la         *
+ * variance de chaque binomiale reste sous un million ; au-delà, les          *
+ * binomiales sont tirées par une approximation normale corrigée, dont        *
+ * l'erreur sur chaque effectif est bien inférieure à un lapin.               *
+ *                                                                            *
+ ******************************************************************************/
+
+typedef struct ParametresSimu
+{
+    unsigned int taille;            // sizeof(ParametresSimu) de l'appelant
+    int age_max;                    // Nombre de classes d'âge (16)
+    int age_maturite;               // Âge à partir duquel une lapine met bas (1)
+    int age_senescence;             // Âge à partir duquel la survie décroît (10)
+    double survie_petit;            // Probabilité de survie d'un bébé (0.12)
+    double survie_adulte;           // Probabilité de survie d'un adulte (0.60)
+    double decroissance_senescence; // Perte de survie par année de sénescence (0.1)
+    double proba_femelle;           // Probabilité qu'un bébé soit une femelle (0.5)
+    int portee_min;                 // Plus petit nombre de portées par an (4)
+    int nb_classes_portee;          // Nombre de classes de portées (5)
+    double repartition_portee[SIMU_MAX_PORTEE];
+    int lapins_portee_min;          // Plus petit nombre de lapins par portée (3)
+    int lapins_portee_max;          // Plus grand nombre de lapins par portée (6)
+    unsigned long graine;           // Graine du générateur MT19937 (5489)
+    int flux_communs;               // Nombres aléatoires communs (0)
+    int reserve_v2;                 // Remplissage explicite, ignoré
+    int tirages_agreges;            // Tirages binomiaux par cohorte (0)
+    int reserve_v3;                 // Remplissage explicite, ignoré
+} ParametresSimu;
+
+//  Taille de ParametresSimu dans les versions précédentes de l'ABI : avant
+//  l'ajout de flux_communs (V1), puis avant celui de tirages_agreges (V2). Les
+//  champs absents chez l'appelant prennent leur valeur par défaut.
+//
+//  Chaque version se termine par un champ de réserve plutôt que par le
+//  remplissage implicite du compilateur : un nouveau champ ne doit jamais
+//  tomber dans ce remplissage, sans quoi la taille de la structure ne
+//  changerait pas et la bibliothèque lirait les octets quelconques d'un
+//  appelant plus ancien comme une valeur du champ.
+#define SIMU_TAILLE_PARAMETRES_V1 offsetof(ParametresSimu, flux_communs)
+#define SIMU_TAILLE_PARAMETRES_V2 offsetof(ParametresSimu, tirages_agreges)
+
+//  Poignée opaque sur une simulation.
+typedef struct Simulation Simulation;
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+SIMU_API int SimuVersionAbi(void);
+
+SIMU_API int ParametresSimuDefautTaille(ParametresSimu *params, size_t taille);
+
+SIMU_API void ParametresSimuDefaut(ParametresSimu *params);
+
+//  La fonction ParametresSimuDefaut ne remplit que les champs de la version 1,
+//  pour les programmes compilés avant l'ajout de ParametresSimuDefautTaille.
+//  Un programme compilé avec cet en-tête passe la taille de sa structure :
+//  la bibliothèque n'écrit jamais au-delà, quelle que soit sa version.
+#define ParametresSimuDefaut(params) ((void)ParametresSimuDefautTaille((params), sizeof(*(params))))
+
+SIMU_API Simulation *SimulationCreer(const ParametresSimu *params);
+
+SIMU_API Simulation *SimulationCreerReplique(const ParametresSimu *params, unsigned long long replique);
+
+SIMU_API void SimulationDetruire(Simulation *sim);
+
+SIMU_API int SimulationPeupler(Simulation *sim, int ligne, int age, unsigned long long nombre);
+
+SIMU_API int SimulationAvancer(Simulation *sim, int nb_annee);
+
+SIMU_API int SimulationNbAnnees(const Simulation *sim);
+
+SIMU_API int SimulationAgeMax(const Simulation *sim);
+
+SIMU_API const unsigned long long *SimulationCohorte(const Simulation *sim, int annee, int ligne);
+
+SIMU_API const unsigned long long *SimulationDonnees(const Simulation *sim);
+
+SIMU_API Simulation *SimulationCopier(const Simulation *sim, int nb_annee);
+
+SIMU_API int SimulationModifierParametres(Simulation *sim, const ParametresSimu *params);
+
+SIMU_API size_t SimulationTailleMemoire(const Simulation *sim);
+
+SIMU_API const unsigned long long *SimulationPortees(const Simulation *sim, int annee);
+
+SIMU_API int SimulationFixerTirages(Simulation *sim, int antithetique, const double *premiers, int nb_premiers);
+
+SIMU_API int SimulationTiragesParAnnee(const Simulation *sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,920 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Bibliothèque : trajectoires.c                                         *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Écriture et lecture des fichiers de trajectoires décrits dans         *
+ *      trajectoires.h.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+//  Ce fichier demande POSIX (mmap, ftruncate), même compilé en C99 strict.
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trajectoires.h"
+
+/* -------------------------------------------------------------------------- */
+/*                                Constantes                                  */
+/* -------------------------------------------------------------------------- */
+
+#define MAGIQUE "TRAJLAP"
+#define VERSION_TRAJECTOIRES 1
+
+//  Taille maximale d'un entier de 64 bits en varint.
+#define MAX_OCTETS_VARINT 10
+
+/* -------------------------------------------------------------------------- */
+/*                                  Types                                     */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * En-tête du fichier, 128 octets. fin_donnees est la position du premier     *
+ * octet libre des données compressées : les écrivains y réservent leur place *
+ * par une addition atomique, et le fichier est raccourci à cette position    *
+ * quand le créateur le ferme. Les blocs d'une réplique sont numérotés        *
+ * annee / annees_par_bloc, l'index a donc nb_repliques * nb_blocs cases.     *
+ *                                                                            *
+ ******************************************************************************/
+
+typedef struct EnteteTrajectoires
+{
+    char magique[8];
+    unsigned int version;
+    unsigned int compression;
+    unsigned int age_max;
+    unsigned int nb_annee;
+    unsigned int annees_par_bloc;
+    unsigned int nb_blocs;
+    unsigned long long premiere_replique;
+    unsigned long long nb_repliques;
+    unsigned long long debut_index;
+    unsigned long long debut_donnees;
+    unsigned long long fin_donnees;
+    unsigned long long reserve[7];
+} EnteteTrajectoires;
+
+struct Trajectoires
+{
+    int descripteur;
+    int createur;
+    unsigned char *carte;
+    size_t taille_carte;
+    EnteteTrajectoires *entete;
+    unsigned long long *index;
+    size_t nb_valeurs;
+};
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+static Trajectoires *Projeter(int descripteur, size_t taille, int ecriture);
+
+static unsigned long long *Case(const Trajectoires *traj, unsigned long long replique, int bloc);
+
+static int Multiplier(unsigned long long *total, unsigned long long facteur);
+
+static size_t EncoderBloc(const Trajectoires *traj, const unsigned long long *donnees, int premiere,
+                          int derniere, unsigned long long *prediction, unsigned char *sortie);
+
+static int DecoderBloc(const Trajectoires *traj, unsigned long long position, int nb_annees,
+                       unsigned long long *precedent, unsigned long long *courant);
+
+static void Prediction(const Trajectoires *traj, const unsigned long long *precedent,
+                       unsigned long long *prediction);
+
+/* -------------------------------------------------------------------------- */
+/*                         Fonctions de l'interface                           */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : Trajectoires *TrajectoiresCreer(const char *chemin,             *
+ *                  int age_max, int nb_annee,                                *
+ *                  unsigned long long premiere_replique,                     *
+ *                  unsigned long long nb_repliques, int compression)         *
+ *                                                                            *
+ * Crée (ou écrase) un fichier de trajectoires pour les répliques             *
+ * premiere_replique à premiere_replique + nb_repliques - 1, et le projette   *
+ * en mémoire en écriture. Le fichier est créé creux : sa place sur le disque *
+ * ne grandit qu'au fur et à mesure des écritures. Avec TRAJ_DELTA, il est    *
+ * dimensionné pour le pire cas puis raccourci par TrajectoiresFermer.        *
+ *                                                                            *
+ * En entrée : Le chemin du fichier                                           *
+ *             Le nombre de classes d'âge des simulations                     *
+ *             Le nombre d'années de chaque réplique                          *
+ *             Le numéro de la première réplique du fichier                   *
+ *             Le nombre de répliques                                         *
+ *             TRAJ_BRUT ou TRAJ_DELTA                                        *
+ *                                                                            *
+ * En sortie : La poignée sur le fichier                                      *
+ *             NULL si les paramètres sont invalides, si la taille du fichier *
+ *             ne tient pas dans un size_t ou si le fichier ne peut pas être  *
+ *             créé.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+Trajectoires *TrajectoiresCreer(const char *chemin, int age_max, int nb_annee,
+                                unsigned long long premiere_replique,
+                                unsigned long long nb_repliques, int compression)
+{
+
+    int descripteur;
+    unsigned int annees_par_bloc, nb_blocs;
+    unsigned long long nb_valeurs, debut_donnees, taille_donnees, taille;
+    Trajectoires *traj;
+    EnteteTrajectoires *entete;
+
+    if (chemin == NULL || age_max < 1 || nb_annee < 1 || nb_repliques == 0 ||
+        (compression != TRAJ_BRUT && compression != TRAJ_DELTA))
+    {
+        return NULL;
+    }
+
+    annees_par_bloc = compression == TRAJ_DELTA ? TRAJ_ANNEES_PAR_BLOC : (unsigned int)nb_annee;
+    nb_blocs = (nb_annee + annees_par_bloc - 1) / annees_par_bloc;
+    nb_valeurs = (unsigned long long)SIMU_NB_LIGNES * age_max;
+
+    //  Avec la compression, chaque valeur peut prendre jusqu'à 10 octets.
+    //  Chaque produit est vérifié : une taille repliée donnerait un fichier
+    //  trop petit, où TrajectoiresEcrire déborderait.
+    debut_donnees = nb_repliques;
+    taille_donnees = nb_repliques;
+    if (!Multiplier(&debut_donnees, (unsigned long long)nb_blocs * sizeof(unsigned long long)) ||
+        debut_donnees > ULLONG_MAX - sizeof(EnteteTrajectoires) ||
+        !Multiplier(&taille_donnees, (unsigned long long)nb_annee) ||
+        !Multiplier(&taille_donnees, nb_valeurs) ||
+        !Multiplier(&taille_donnees, compression == TRAJ_DELTA ? MAX_OCTETS_VARINT : sizeof(unsigned long long)))
+    {
+        return NULL;
+    }
+    debut_donnees += sizeof(EnteteTrajectoires);
+
+    if (taille_donnees > ULLONG_MAX - debut_donnees)
+    {
+        return NULL;
+    }
+    taille = debut_donnees + taille_donnees;
+    if (taille > SIZE_MAX || (off_t)taille < 0 || (unsigned long long)(off_t)taille != taille)
+    {
+        return NULL;
+    }
+
+    descripteur = open(chemin, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descripteur < 0)
+    {
+        return NULL;
+    }
+
+    if (ftruncate(descripteur, (off_t)taille) != 0)
+    {
+        close(descripteur);
+        return NULL;
+    }
+
+    traj = Projeter(descripteur, (size_t)taille, 1);
+    if (traj == NULL)
+    {
+        return NULL;
+    }
+
+    //  Le fichier vient d'être créé : l'index est déjà rempli de zéros.
+    entete = traj->entete;
+    memcpy(entete->magique, MAGIQUE, sizeof(MAGIQUE));
+    entete->version = VERSION_TRAJECTOIRES;
+    entete->compression = (unsigned int)compression;
+    entete->age_max = (unsigned int)age_max;
+    entete->nb_annee = (unsigned int)nb_annee;
+    entete->annees_par_bloc = annees_par_bloc;
+    entete->nb_blocs = nb_blocs;
+    entete->premiere_replique = premiere_replique;
+    entete->nb_repliques = nb_repliques;
+    entete->debut_index = sizeof(EnteteTrajectoires);
+    entete->debut_donnees = debut_donnees;
+    entete->fin_donnees = debut_donnees;
+
+    traj->index = (unsigned long long *)(traj->carte + entete->debut_index);
+    traj->nb_valeurs = (size_t)nb_valeurs;
+    traj->createur = 1;
+
+    return traj;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : Trajectoires *TrajectoiresOuvrir(const char *chemin)            *
+ *                                                                            *
+ * Ouvre un fichier de trajectoires existant en lecture seule et vérifie la   *
+ * cohérence de son en-tête : l'index, et sans compression toutes les         *
+ * données, doivent tenir dans le fichier. Rien n'est lu d'autre que          *
+ * l'en-tête.                                                                 *
+ *                                                                            *
+ * En entrée : Le chemin du fichier.                                          *
+ *                                                                            *
+ * En sortie : La poignée sur le fichier                                      *
+ *             NULL si le fichier n'existe pas ou n'est pas valide.           *
+ *                                                                            *
+ ******************************************************************************/
+
+Trajectoires *TrajectoiresOuvrir(const char *chemin)
+{
+
+    int descripteur;
+    struct stat etat;
+    Trajectoires *traj;
+    const EnteteTrajectoires *entete;
+    unsigned long long taille, taille_index, taille_replique;
+
+    descripteur = open(chemin, O_RDONLY);
+    if (descripteur < 0)
+    {
+        return NULL;
+    }
+
+    if (fstat(descripteur, &etat) != 0 || (unsigned long long)etat.st_size < sizeof(EnteteTrajectoires))
+    {
+        close(descripteur);
+        return NULL;
+    }
+    taille = (unsigned long long)etat.st_size;
+
+    traj = Projeter(descripteur, (size_t)taille, 0);
+    if (traj == NULL)
+    {
+        return NULL;
+    }
+
+    entete = traj->entete;
+
+    //  Un fichier brut n'a qu'un bloc par réplique, qui contient toutes ses
+    //  années.
+    if (memcmp(entete->magique, MAGIQUE, sizeof(MAGIQUE)) != 0 ||
+        entete->version != VERSION_TRAJECTOIRES ||
+        (entete->compression != TRAJ_BRUT && entete->compression != TRAJ_DELTA) ||
+        entete->age_max < 1 || entete->age_max > INT_MAX ||
+        entete->nb_annee < 1 || entete->nb_annee > INT_MAX || entete->annees_par_bloc < 1 ||
+        entete->nb_blocs != ((unsigned long long)entete->nb_annee + entete->annees_par_bloc - 1) /
+                            entete->annees_par_bloc ||
+        (entete->compression == TRAJ_BRUT && entete->annees_par_bloc != entete->nb_annee) ||
+        entete->debut_index != sizeof(EnteteTrajectoires))
+    {
+        TrajectoiresFermer(traj);
+        return NULL;
+    }
+
+    //  Les tailles sont bornées par celle du fichier avant d'être multipliées.
+    taille_index = (unsigned long long)entete->nb_blocs * sizeof(unsigned long long);
+    if (entete->nb_repliques > (taille - sizeof(EnteteTrajectoires)) / taille_index)
+    {
+        TrajectoiresFermer(traj);
+        return NULL;
+    }
+    taille_index *= entete->nb_repliques;
+
+    if (entete->debut_donnees != entete->debut_index + taille_index || entete->debut_donnees > taille ||
+        entete->fin_donnees < entete->debut_donnees || entete->fin_donnees > taille)
+    {
+        TrajectoiresFermer(traj);
+        return NULL;
+    }
+
+    if (entete->compression == TRAJ_BRUT)
+    {
+        taille_replique = (unsigned long long)SIMU_NB_LIGNES * entete->age_max * sizeof(unsigned long long);
+        if (!Multiplier(&taille_replique, entete->nb_annee) ||
+            (taille_replique > 0 &&
+             entete->nb_repliques > (taille - entete->debut_donnees) / taille_replique))
+        {
+            TrajectoiresFermer(traj);
+            return NULL;
+        }
+    }
+
+    traj->index = (unsigned long long *)(traj->carte + entete->debut_index);
+    traj->nb_valeurs = (size_t)SIMU_NB_LIGNES * entete->age_max;
+
+    return traj;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int TrajectoiresFermer(Trajectoires *traj)                      *
+ *                                                                            *
+ * Ferme le fichier. S'il a été créé avec TRAJ_DELTA par cette poignée, il    *
+ * est d'abord raccourci à la fin des données écrites. Les processus fils     *
+ * qui ont écrit dans une projection héritée ne doivent pas la fermer.        *
+ *                                                                            *
+ * En entrée : La poignée (NULL est accepté).                                 *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_FICHIER.                                *
+ *                                                                            *
+ ******************************************************************************/
+
+int TrajectoiresFermer(Trajectoires *traj)
+{
+
+    int erreur = SIMU_OK;
+    unsigned long long fin = 0;
+
+    if (traj == NULL)
+    {
+        return SIMU_OK;
+    }
+
+    if (traj->createur && traj->entete->compression == TRAJ_DELTA)
+    {
+        fin = traj->entete->fin_donnees;
+    }
+
+    if (munmap(traj->carte, traj->taille_carte) != 0)
+    {
+        erreur = SIMU_ERREUR_FICHIER;
+    }
+    if (fin > 0 && ftruncate(traj->descripteur, (off_t)fin) != 0)
+    {
+        erreur = SIMU_ERREUR_FICHIER;
+    }
+    if (close(traj->descripteur) != 0)
+    {
+        erreur = SIMU_ERREUR_FICHIER;
+    }
+
+    free(traj);
+
+    return erreur;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int TrajectoiresEcrire(Trajectoires *traj,                      *
+ *                  unsigned long long replique,                              *
+ *                  const unsigned long long *donnees)                        *
+ *                                                                            *
+ * Écrit toutes les années d'une réplique. Plusieurs threads ou processus     *
+ * peuvent écrire en même temps des répliques différentes. La case d'index    *
+ * d'un bloc n'est remplie qu'une fois ses données écrites.                   *
+ *                                                                            *
+ * En entrée : Le fichier, créé par TrajectoiresCreer                         *
+ *             Le numéro de la réplique                                       *
+ *             Ses données, de la forme [Année][Ligne][Âge] comme celles de   *
+ *             SimulationDonnees, sur toutes les années du fichier            *
+ *                                                                            *
+ * En sortie : SIMU_OK                                                        *
+ *             SIMU_ERREUR_PARAMETRE si la réplique n'est pas dans le fichier *
+ *             SIMU_ERREUR_MEMOIRE si la mémoire manque                       *
+ *             SIMU_ERREUR_FICHIER si le fichier est plein.                   *
+ *                                                                            *
+ ******************************************************************************/
+
+int TrajectoiresEcrire(Trajectoires *traj, unsigned long long replique, const unsigned long long *donnees)
+{
+
+    int bloc, premiere, derniere;
+    size_t taille;
+    unsigned long long position;
+    unsigned long long *prediction;
+    unsigned char *tampon;
+    EnteteTrajectoires *entete;
+
+    if (traj == NULL || donnees == NULL || !traj->createur || Case(traj, replique, 0) == NULL)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+    entete = traj->entete;
+
+    if (entete->compression == TRAJ_BRUT)
+    {
+        //  Place fixe : [Réplique][Année][Ligne][Âge].
+        taille = entete->nb_annee * traj->nb_valeurs * sizeof(unsigned long long);
+        position = entete->debut_donnees + (replique - entete->premiere_replique) * taille;
+
+        memcpy(traj->carte + position, donnees, taille);
+        __atomic_store_n(Case(traj, replique, 0), position, __ATOMIC_RELEASE);
+
+        return SIMU_OK;
+    }
+
+    tampon = (unsigned char *)malloc(entete->annees_par_bloc * traj->nb_valeurs * MAX_OCTETS_VARINT);
+    prediction = (unsigned long long *)malloc(traj->nb_valeurs * sizeof(unsigned long long));
+    if (tampon == NULL || prediction == NULL)
+    {
+        free(tampon);
+        free(prediction);
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    for (bloc = 0; bloc < (int)entete->nb_blocs; bloc++)
+    {
+        premiere = bloc * entete->annees_par_bloc;
+        derniere = premiere + entete->annees_par_bloc;
+        if (derniere > (int)entete->nb_annee)
+        {
+            derniere = entete->nb_annee;
+        }
+
+        //  On code le bloc à part, puis on réserve juste la place qu'il
+        //  prend à la fin des données.
+        taille = EncoderBloc(traj, donnees, premiere, derniere, prediction, tampon);
+        position = __atomic_fetch_add(&entete->fin_donnees, (unsigned long long)taille, __ATOMIC_RELAXED);
+
+        //  La place du pire cas est prévue une fois par réplique : seule une
+        //  réplique écrite plusieurs fois peut la dépasser.
+        if (position + taille > traj->taille_carte)
+        {
+            free(tampon);
+            free(prediction);
+            return SIMU_ERREUR_FICHIER;
+        }
+
+        memcpy(traj->carte + position, tampon, taille);
+        __atomic_store_n(Case(traj, replique, bloc), position, __ATOMIC_RELEASE);
+    }
+
+    free(tampon);
+    free(prediction);
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int TrajectoiresLire(const Trajectoires *traj,                  *
+ *                  unsigned long long replique, int annee,                   *
+ *                  unsigned long long *enregistrement)                       *
+ *                                                                            *
+ * Copie une année d'une réplique. Sans compression, c'est une simple copie ; *
+ * avec TRAJ_DELTA, on décode le bloc de l'année depuis son début, soit au    *
+ * plus TRAJ_ANNEES_PAR_BLOC enregistrements quelle que soit la taille du     *
+ * fichier.                                                                   *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             Le numéro de la réplique                                       *
+ *             L'année                                                        *
+ *             Le tableau à remplir, de SIMU_NB_LIGNES * age_max valeurs      *
+ *             ([Ligne][Âge])                                                 *
+ *                                                                            *
+ * En sortie : SIMU_OK                                                        *
+ *             SIMU_ERREUR_PARAMETRE si l'enregistrement n'existe pas         *
+ *             SIMU_ERREUR_FICHIER si le fichier est corrompu                 *
+ *             SIMU_ERREUR_MEMOIRE si la mémoire manque.                      *
+ *                                                                            *
+ ******************************************************************************/
+
+int TrajectoiresLire(const Trajectoires *traj, unsigned long long replique, int annee,
+                     unsigned long long *enregistrement)
+{
+
+    int erreur;
+    const unsigned long long *brut;
+    unsigned long long *case_index, *precedent;
+    const EnteteTrajectoires *entete;
+
+    if (traj == NULL || enregistrement == NULL || annee < 0 || annee >= (int)traj->entete->nb_annee)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+    entete = traj->entete;
+
+    if (entete->compression == TRAJ_BRUT)
+    {
+        brut = TrajectoiresEnregistrement(traj, replique, annee);
+        if (brut == NULL)
+        {
+            return TrajectoiresPresente(traj, replique) ? SIMU_ERREUR_FICHIER : SIMU_ERREUR_PARAMETRE;
+        }
+        memcpy(enregistrement, brut, traj->nb_valeurs * sizeof(unsigned long long));
+
+        return SIMU_OK;
+    }
+
+    case_index = Case(traj, replique, annee / entete->annees_par_bloc);
+    if (case_index == NULL || *case_index == 0)
+    {
+        return SIMU_ERREUR_PARAMETRE;
+    }
+
+    precedent = (unsigned long long *)malloc(traj->nb_valeurs * sizeof(unsigned long long));
+    if (precedent == NULL)
+    {
+        return SIMU_ERREUR_MEMOIRE;
+    }
+
+    erreur = DecoderBloc(traj, *case_index, annee % entete->annees_par_bloc + 1, precedent, enregistrement);
+    free(precedent);
+
+    return erreur;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : const unsigned long long *TrajectoiresEnregistrement(           *
+ *                  const Trajectoires *traj, unsigned long long replique,    *
+ *                  int annee)                                                *
+ *                                                                            *
+ * Donne accès sans copie à une année d'une réplique, directement dans la     *
+ * projection du fichier.                                                     *
+ *                                                                            *
+ * En entrée : Le fichier, sans compression                                   *
+ *             Le numéro de la réplique                                       *
+ *             L'année                                                        *
+ *                                                                            *
+ * En sortie : Un pointeur sur SIMU_NB_LIGNES * age_max valeurs, valable      *
+ *             jusqu'à la fermeture du fichier                                *
+ *             NULL si le fichier est compressé ou si l'enregistrement        *
+ *             n'existe pas.                                                  *
+ *                                                                            *
+ ******************************************************************************/
+
+const unsigned long long *TrajectoiresEnregistrement(const Trajectoires *traj, unsigned long long replique,
+                                                     int annee)
+{
+
+    unsigned long long *case_index, position, taille, decalage;
+
+    if (traj == NULL || traj->entete->compression != TRAJ_BRUT || annee < 0 ||
+        annee >= (int)traj->entete->nb_annee)
+    {
+        return NULL;
+    }
+
+    case_index = Case(traj, replique, 0);
+    if (case_index == NULL || *case_index == 0)
+    {
+        return NULL;
+    }
+
+    //  La position vient du fichier : on la borne sans addition qui puisse
+    //  se replier, comme DecoderBloc le fait pour chaque octet.
+    taille = traj->nb_valeurs * sizeof(unsigned long long);
+    decalage = (unsigned long long)annee * taille;
+    if (*case_index < traj->entete->debut_donnees || *case_index > traj->taille_carte ||
+        decalage > traj->taille_carte - *case_index || taille > traj->taille_carte - *case_index - decalage)
+    {
+        return NULL;
+    }
+    position = *case_index + decalage;
+    if (position % sizeof(unsigned long long) != 0)
+    {
+        return NULL;
+    }
+
+    return (const unsigned long long *)(traj->carte + position);
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int TrajectoiresPresente(const Trajectoires *traj,              *
+ *                                     unsigned long long replique)           *
+ *                                                                            *
+ * En sortie : 1 si la réplique est dans le fichier et a été écrite           *
+ *             0 sinon.                                                       *
+ *                                                                            *
+ ******************************************************************************/
+
+int TrajectoiresPresente(const Trajectoires *traj, unsigned long long replique)
+{
+
+    unsigned long long *case_index;
+
+    if (traj == NULL)
+    {
+        return 0;
+    }
+
+    //  Le dernier bloc est écrit en dernier.
+    case_index = Case(traj, replique, traj->entete->nb_blocs - 1);
+
+    return case_index != NULL && *case_index != 0;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Accesseurs sur l'en-tête du fichier. TrajectoiresTailleDonnees donne le    *
+ * nombre d'octets de données écrits (compressés ou non).                     *
+ *                                                                            *
+ ******************************************************************************/
+
+int TrajectoiresAgeMax(const Trajectoires *traj)
+{
+    return (int)traj->entete->age_max;
+}
+
+int TrajectoiresNbAnnees(const Trajectoires *traj)
+{
+    return (int)traj->entete->nb_annee;
+}
+
+unsigned long long TrajectoiresPremiereReplique(const Trajectoires *traj)
+{
+    return traj->entete->premiere_replique;
+}
+
+unsigned long long TrajectoiresNbRepliques(const Trajectoires *traj)
+{
+    return traj->entete->nb_repliques;
+}
+
+int TrajectoiresCompression(const Trajectoires *traj)
+{
+    return (int)traj->entete->compression;
+}
+
+unsigned long long TrajectoiresTailleDonnees(const Trajectoires *traj)
+{
+    if (traj->entete->compression == TRAJ_BRUT)
+    {
+        return traj->entete->nb_repliques * traj->entete->nb_annee * traj->nb_valeurs * sizeof(unsigned long long);
+    }
+
+    return traj->entete->fin_donnees - traj->entete->debut_donnees;
+}
+
+/* -------------------------------------------------------------------------- */
+/*                            Fonctions internes                              */
+/* -------------------------------------------------------------------------- */
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : Trajectoires *Projeter(int descripteur, size_t taille,          *
+ *                                   int ecriture)                            *
+ *                                                                            *
+ * Projette tout le fichier en mémoire, partagée pour que les écritures des   *
+ * processus fils soient vues par le père et arrivent dans le fichier.        *
+ *                                                                            *
+ * En entrée : Le descripteur du fichier ouvert                               *
+ *             La taille du fichier                                           *
+ *             1 pour une projection en écriture, 0 en lecture seule          *
+ *                                                                            *
+ * En sortie : La poignée, NULL en cas d'échec (le descripteur est alors      *
+ *             fermé).                                                        *
+ *                                                                            *
+ ******************************************************************************/
+
+static Trajectoires *Projeter(int descripteur, size_t taille, int ecriture)
+{
+
+    void *carte;
+    Trajectoires *traj = (Trajectoires *)calloc(1, sizeof(Trajectoires));
+
+    if (traj == NULL)
+    {
+        close(descripteur);
+        return NULL;
+    }
+
+    carte = mmap(NULL, taille, ecriture ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descripteur, 0);
+    if (carte == MAP_FAILED)
+    {
+        close(descripteur);
+        free(traj);
+        return NULL;
+    }
+
+    traj->descripteur = descripteur;
+    traj->carte = (unsigned char *)carte;
+    traj->taille_carte = taille;
+    traj->entete = (EnteteTrajectoires *)carte;
+
+    return traj;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : unsigned long long *Case(const Trajectoires *traj,              *
+ *                                     unsigned long long replique, int bloc) *
+ *                                                                            *
+ * En sortie : La case d'index d'un bloc d'une réplique                       *
+ *             NULL si la réplique n'est pas dans le fichier.                 *
+ *                                                                            *
+ ******************************************************************************/
+
+static unsigned long long *Case(const Trajectoires *traj, unsigned long long replique, int bloc)
+{
+    if (traj == NULL || replique < traj->entete->premiere_replique ||
+        replique - traj->entete->premiere_replique >= traj->entete->nb_repliques)
+    {
+        return NULL;
+    }
+
+    return traj->index + (replique - traj->entete->premiere_replique) * traj->entete->nb_blocs + bloc;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int Multiplier(unsigned long long *total,                       *
+ *                           unsigned long long facteur)                      *
+ *                                                                            *
+ * Multiplie un total par un facteur, si le résultat tient sur 64 bits.       *
+ *                                                                            *
+ * En sortie : 1 si la multiplication a été faite                             *
+ *             0 sinon, le total n'est alors pas modifié.                     *
+ *                                                                            *
+ ******************************************************************************/
+
+static int Multiplier(unsigned long long *total, unsigned long long facteur)
+{
+    if (facteur != 0 && *total > ULLONG_MAX / facteur)
+    {
+        return 0;
+    }
+
+    *total *= facteur;
+
+    return 1;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : size_t EncoderBloc(const Trajectoires *traj,                    *
+ *                  const unsigned long long *donnees, int premiere,          *
+ *                  int derniere, unsigned long long *prediction,             *
+ *                  unsigned char *sortie)                                    *
+ *                                                                            *
+ * Code les années premiere à derniere - 1 d'une réplique : chaque valeur     *
+ * devient l'écart avec sa prédiction (0 pour la première année du bloc), en  *
+ * zigzag puis en varint.                                                     *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             Les données de la réplique ([Année][Ligne][Âge])               *
+ *             La première année du bloc et l'année qui suit la dernière      *
+ *             Un tableau de travail de SIMU_NB_LIGNES * age_max valeurs      *
+ *             Le tampon de sortie, assez grand pour le pire cas              *
+ *                                                                            *
+ * En sortie : Le nombre d'octets écrits.                                     *
+ *                                                                            *
+ ******************************************************************************/
+
+static size_t EncoderBloc(const Trajectoires *traj, const unsigned long long *donnees, int premiere,
+                          int derniere, unsigned long long *prediction, unsigned char *sortie)
+{
+
+    int annee;
+    size_t i, taille = 0;
+    unsigned long long ecart, zigzag;
+    const unsigned long long *courant;
+
+    memset(prediction, 0, traj->nb_valeurs * sizeof(unsigned long long));
+
+    for (annee = premiere; annee < derniere; annee++)
+    {
+        courant = donnees + (size_t)annee * traj->nb_valeurs;
+
+        if (annee > premiere)
+        {
+            Prediction(traj, courant - traj->nb_valeurs, prediction);
+        }
+
+        for (i = 0; i < traj->nb_valeurs; i++)
+        {
+            //  Écart signé sur 64 bits, replié en zigzag : 0, -1, 1, -2, ...
+            //  deviennent 0, 1, 2, 3, ... puis 7 bits par octet.
+            ecart = courant[i] - prediction[i];
+            zigzag = (ecart << 1) ^ (0 - (ecart >> 63));
+
+            while (zigzag >= 0x80)
+            {
+                sortie[taille++] = (unsigned char)(zigzag | 0x80);
+                zigzag >>= 7;
+            }
+            sortie[taille++] = (unsigned char)zigzag;
+        }
+    }
+
+    return taille;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : int DecoderBloc(const Trajectoires *traj,                       *
+ *                  unsigned long long position, int nb_annees,               *
+ *                  unsigned long long *precedent,                            *
+ *                  unsigned long long *courant)                              *
+ *                                                                            *
+ * Décode les nb_annees premières années d'un bloc et laisse la dernière dans *
+ * courant. Chaque lecture est bornée par la taille du fichier.               *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             La position du bloc                                            *
+ *             Le nombre d'années à décoder                                   *
+ *             Un tableau de travail et le tableau de sortie, de              *
+ *             SIMU_NB_LIGNES * age_max valeurs chacun                        *
+ *                                                                            *
+ * En sortie : SIMU_OK ou SIMU_ERREUR_FICHIER.                                *
+ *                                                                            *
+ ******************************************************************************/
+
+static int DecoderBloc(const Trajectoires *traj, unsigned long long position, int nb_annees,
+                       unsigned long long *precedent, unsigned long long *courant)
+{
+
+    int annee, decalage;
+    size_t i;
+    unsigned long long zigzag, octet;
+
+    memset(courant, 0, traj->nb_valeurs * sizeof(unsigned long long));
+
+    for (annee = 0; annee < nb_annees; annee++)
+    {
+        //  courant contient l'année précédente, dont on tire la prédiction.
+        if (annee > 0)
+        {
+            memcpy(precedent, courant, traj->nb_valeurs * sizeof(unsigned long long));
+            Prediction(traj, precedent, courant);
+        }
+
+        for (i = 0; i < traj->nb_valeurs; i++)
+        {
+            zigzag = 0;
+            decalage = 0;
+            do
+            {
+                if (position >= traj->taille_carte || decalage >= 7 * MAX_OCTETS_VARINT)
+                {
+                    return SIMU_ERREUR_FICHIER;
+                }
+                octet = traj->carte[position++];
+                zigzag |= (octet & 0x7f) << decalage;
+                decalage += 7;
+            } while (octet & 0x80);
+
+            courant[i] += (zigzag >> 1) ^ (0 - (zigzag & 1));
+        }
+    }
+
+    return SIMU_OK;
+}
+
+/******************************************************************************
+ *                                                                            *
+ * Fonction : void Prediction(const Trajectoires *traj,                       *
+ *                  const unsigned long long *precedent,                      *
+ *                  unsigned long long *prediction)                           *
+ *                                                                            *
+ * Prédit une année à partir de la précédente : les vivants d'âge a sont les  *
+ * vivants d'âge a - 1 moins leurs morts, ce qui est exact pour toutes les    *
+ * années simulées. Les naissances (âge 0) et les morts sont prédites égales  *
+ * à celles de l'année précédente.                                            *
+ *                                                                            *
+ * En entrée : Le fichier                                                     *
+ *             L'année précédente ([Ligne][Âge])                              *
+ *             Le tableau à remplir                                           *
+ *                                                                            *
+ * En sortie : Rien.                                                          *
+ *                                                                            *
+ ******************************************************************************/
+
+static void Prediction(const Trajectoires *traj, const unsigned long long *precedent,
+                       unsigned long long *prediction)
+{
+
+    int i, age;
+    int age_max = (int)traj->entete->age_max;
+    int lignes_vivants[2] = {SIMU_FEMELLES, SIMU_MALES};
+    int lignes_morts[2] = {SIMU_FEMELLES_MORTES, SIMU_MALES_MORTS};
+    const unsigned long long *vivants, *morts;
+
+    memcpy(prediction, precedent, traj->nb_valeurs * sizeof(unsigned long long));
+
+    for (i = 0; i < 2; i++)
+    {
+        vivants = precedent + lignes_vivants[i] * age_max;
+        morts = precedent + lignes_morts[i] * age_max;
+
+        for (age = 1; age < age_max; age++)
+        {
+            prediction[lignes_vivants[i] * age_max + age] = vivants[age - 1] - morts[age - 1];
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/******************************************************************************
+ *           ██╗   ██╗██████╗        ██╗       ██╗      ██████╗               *
+ *           ██║   ██║██╔══██╗       ██║       ██║     ██╔════╝               *
+ *           ██║   ██║██████╔╝    ████████╗    ██║     ██║                    *
+ *           ╚██╗ ██╔╝██╔══██╗    ██╔═██╔═╝    ██║     ██║                    *
+ *            ╚████╔╝ ██████╔╝    ██████║      ███████╗╚██████╗               *
+ *             ╚═══╝  ╚═════╝     ╚═════╝      ╚══════╝ ╚═════╝               *
+ *                                                                            *
+ *                                                                            *
+ *      ██████╗ ██████╗  ██████╗  ██████╗ ██████╗  █████╗ ███╗   ███╗         *
+ *      ██╔══██╗██╔══██╗██╔═══██╗██╔════╝ ██╔══██╗██╔══██╗████╗ ████║         *
+ *      ██████╔╝██████╔╝██║   ██║██║  ███╗██████╔╝███████║██╔████╔██║         *
+ *      ██╔═══╝ ██╔══██╗██║   ██║██║   ██║██╔══██╗██╔══██║██║╚██╔╝██║         *
+ *      ██║     ██║  ██║╚██████╔╝╚██████╔╝██║  ██║██║  ██║██║ ╚═╝ ██║         *
+ *      ╚═╝     ╚═╝  ╚═╝ ╚═════╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝         *
+ *                                                                            *
+ *                                                                            *
+ *      Auteur : Boursat Vincent                                              *
+ *               Corcos  Ludovic                                              *
+ *                                                                            *
+ *      Université Clermont Auvergne | L2 Informatique                        *
+ *                                                                            *
+ *      Date : 19/10/2026                                                     *
+ *                                                                            *
+ *      Bibliothèque : trajectoires.h                                         *
+ *                                                                            *
+ *      Description :                                                         *
+ *      Stockage des trajectoires d'un ensemble de répliques dans un fichier  *
+ *      projeté en mémoire (mmap), pour relire n'importe quelle réplique et   *
+ *      n'importe quelle année sans parcourir le reste du fichier. Le         *
+ *      fichier n'est jamais chargé en entier : seules les pages lues sont    *
+ *      amenées en mémoire, ce qui rend consultables des résultats de         *
+ *      plusieurs centaines de gigaoctets.                                    *
+ *                                                                            *
+ *      Il forme la bibliothèque simu_traj, séparée de simu_lapin pour que    *
+ *      le moteur reste compilable sans mmap. Elle se compile sur un système  *
+ *      POSIX, à côté de simu_lapin (voir simu_lapin.h) :                     *
+ *      gcc -Wall -O2 -fPIC -c trajectoires.c                                 *
+ *      ar rcs libsimu_traj.a trajectoires.o                                  *
+ *      gcc -shared -o libsimu_traj.so trajectoires.o -L. -lsimu_lapin        *
+ *      Ses clients la lient avant simu_lapin : -lsimu_traj -lsimu_lapin.     *
+ *                                                                            *
+ *      Format du fichier (dans le boutisme de la machine qui l'a écrit) :    *
+ *        - un en-tête de 128 octets (voir EnteteTrajectoires dans            *
+ *          trajectoires.c) ;                                                 *
+ *        - l'index : pour chaque réplique et chaque bloc d'années, la        *
+ *          position du bloc dans le fichier, 0 s'il n'a pas été écrit ;      *
+ *        - les données. Un enregistrement est une année d'une réplique, de   *
+ *          la forme [Ligne][Âge] comme dans SimulationDonnees.               *
+ *                                                                            *
+ *      Sans compression, les enregistrements sont bruts et à pas fixe :      *
+ *      [Réplique][Année][Ligne][Âge], et un bloc contient toutes les années  *
+ *      d'une réplique. TrajectoiresEnregistrement y donne accès sans copie.  *
+ *                                                                            *
+ *      Avec TRAJ_DELTA, les années sont groupées en blocs de                 *
+ *      TRAJ_ANNEES_PAR_BLOC. La première année d'un bloc est écrite telle    *
+ *      quelle, chaque année suivante par sa différence avec une prédiction   *
+ *      tirée de l'année précédente, en varint (entier de taille variable,    *
+ *      7 bits par octet) après un codage zigzag du signe. La prédiction      *
+ *      d'un vivant d'âge a est le nombre de vivants d'âge a - 1 l'année      *
+ *      précédente moins leurs morts : les survivants ne coûtent donc qu'un   *
+ *      octet. Lire une année revient à décoder au plus                       *
+ *      TRAJ_ANNEES_PAR_BLOC enregistrements.                                 *
+ *                                                                            *
+ *      Plusieurs threads ou processus (après fork) peuvent écrire des        *
+ *      répliques différentes dans le même fichier en même temps : chacune a  *
+ *      sa place fixe, ou réserve la sienne par une addition atomique dans    *
+ *      l'en-tête projeté.                                                    *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef TRAJECTOIRES_H
+#define TRAJECTOIRES_H
+
+#include "simu_lapin.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*                           Constantes publiques                             */
+/* -------------------------------------------------------------------------- */
+
+//  Modes de stockage.
+#define TRAJ_BRUT 0
+#define TRAJ_DELTA 1
+
+//  Nombre d'années par bloc compressé.
+#define TRAJ_ANNEES_PAR_BLOC 8
+
+/* -------------------------------------------------------------------------- */
+/*                             Types publics                                  */
+/* -------------------------------------------------------------------------- */
+
+//  Poignée opaque sur un fichier de trajectoires ouvert.
+typedef struct Trajectoires Trajectoires;
+
+/* -------------------------------------------------------------------------- */
+/*                          Prototypes des fonctions                          */
+/* -------------------------------------------------------------------------- */
+
+SIMU_API Trajectoires *TrajectoiresCreer(const char *chemin, int age_max, int nb_annee,
+                                         unsigned long long premiere_replique,
+                                         unsigned long long nb_repliques, int compression);
+
+SIMU_API Trajectoires *TrajectoiresOuvrir(const char *chemin);
+
+SIMU_API int TrajectoiresFermer(Trajectoires *traj);
+
+SIMU_API int TrajectoiresEcrire(Trajectoires *traj, unsigned long long replique,
+                                const unsigned long long *donnees);
+
+SIMU_API int TrajectoiresLire(const Trajectoires *traj, unsigned long long replique, int annee,
+                              unsigned long long *enregistrement);
+
+SIMU_API const unsigned long long *TrajectoiresEnregistrement(const Trajectoires *traj,
+                                                              unsigned long long replique, int annee);
+
+SIMU_API int TrajectoiresPresente(const Trajectoires *traj, unsigned long long replique);
+
+SIMU_API int TrajectoiresAgeMax(const Trajectoires *traj);
+
+SIMU_API int TrajectoiresNbAnnees(const Trajectoires *traj);
+
+SIMU_API unsigned long long TrajectoiresPremiereReplique(const Trajectoires *traj);
+
+SIMU_API unsigned long long TrajectoiresNbRepliques(const Trajectoires *traj);
+
+SIMU_API int TrajectoiresCompression(const Trajectoires *traj);
+
+SIMU_API unsigned long long TrajectoiresTailleDonnees(const Trajectoires *traj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif